@@ -6,6 +6,7 @@
 class Process {
 public:
     typedef unsigned long long mstime_t;  // milliseconds time value
+    typedef unsigned long long ustime_t;  // microseconds time value
 
 private:
     bool _pendingReload;
@@ -18,6 +19,11 @@ public:
     void     init     ();  // called early during game-init
     void     shutdown ();  // called late during game-shutdown
     mstime_t mstime   ();  // get milliseconds since epoch
+    ustime_t ustime   ();  // get microseconds since arbitrary epoch, for measuring intervals
+    bool     fileSync    ( FILE* );  // flush and commit file to stable storage, true on error
+    bool     fileReplace ( const string&, const string& );  // atomically rename over existing file, true on error
+    time_t   fileTime    ( const string& );  // modification time of file, 0 if missing
+    tm*      localtime   ( time_t, tm& );  // thread-safe localtime()
 
     void beginCriticalSection ();  // put this around code which must not get interrupted
     void endCriticalSection   ();  // put this around code which must not get interrupted
@@ -2,78 +2,228 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SampledStat::SampledStat( mstime_t period_ )
-    : _period         ( period_ )
-    , _fvalue         ( 0.0f )
-    , _ivalue         ( 0 )
-    , _avg            ( 0.0f )
-    , _lastSampleTime ( 0 )
+SampledStat::SampledStat( mstime_t period, uint32 numBuckets_ )
+    : _numBuckets ( numBuckets_ ? numBuckets_ : 1 )
+    , _width      ( period / _numBuckets ? period / _numBuckets : 1 )
+    , _buckets    ( new Bucket[ _numBuckets ] )
 {
-    memset( &_samplesTotal, 0, sizeof(_samplesTotal) );
+    reset();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 SampledStat::~SampledStat()
 {
-    const list<sample_t*>::iterator end = _samples.end();
-    for ( list<sample_t*>::iterator it = _samples.begin(); it != end; it++ )
-        delete *it;
+    delete[] _buckets;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+SampledStat::binHigh( uint32 bin )
+{
+    if (bin < HISTOGRAM_SUB)
+        return bin;
+
+    const uint32 shift = bin / HISTOGRAM_SUB - 1;
+    const uint64 mant  = HISTOGRAM_SUB + bin % HISTOGRAM_SUB;
+    return uint32( ((mant + 1) << shift) - 1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+SampledStat::binOf( uint32 value )
+{
+    if (value < HISTOGRAM_SUB)
+        return value;
+
+    // position of most significant bit
+    uint32 msb = 0;
+    uint32 x = value;
+    if (x >= 1U << 16) { x >>= 16; msb += 16; }
+    if (x >= 1U << 8)  { x >>= 8;  msb += 8;  }
+    if (x >= 1U << 4)  { x >>= 4;  msb += 4;  }
+    if (x >= 1U << 2)  { x >>= 2;  msb += 2;  }
+    if (x >= 1U << 1)  {           msb += 1;  }
+
+    // top HISTOGRAM_BITS+1 bits select the bin within each power of two
+    const uint32 shift = msb - HISTOGRAM_BITS;
+    return (shift + 1) * HISTOGRAM_SUB + ((value >> shift) - HISTOGRAM_SUB);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+SampledStat::count() const
+{
+    const mstime_t now = process.mstime();
+
+    uint32 total = 0;
+    for ( uint32 i = 0; i < _numBuckets; i++ ) {
+        if (valid( _buckets[i], now ))
+            total += _buckets[i].count;
+    }
+
+    return total;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SampledStat::Bucket&
+SampledStat::current( mstime_t now )
+{
+    const mstime_t slot = now / _width;
+    Bucket& b = _buckets[ slot % _numBuckets ];
+
+    if (b.slot != slot) {
+        memset( &b, 0, sizeof(b) );
+        b.slot = slot;
+    }
+
+    return b;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 float
-SampledStat::avg()
+SampledStat::mean() const
 {
     const mstime_t now = process.mstime();
-    if (now - _lastSampleTime > 1000)
-        sample( 0 );
 
-    return _avg;
+    double sum   = 0.0;
+    uint32 total = 0;
+    for ( uint32 i = 0; i < _numBuckets; i++ ) {
+        const Bucket& b = _buckets[i];
+        if (!valid( b, now ))
+            continue;
+
+        sum   += b.sum;
+        total += b.count;
+    }
+
+    return total ? float( sum / total ) : 0.0f;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void
-SampledStat::sample( float f )
+uint32
+SampledStat::peak() const
 {
-    _fvalue = f;
-    _ivalue = int(f);
+    const mstime_t now = process.mstime();
+
+    uint32 result = 0;
+    for ( uint32 i = 0; i < _numBuckets; i++ ) {
+        const Bucket& b = _buckets[i];
+        if (valid( b, now ) && b.peak > result)
+            result = b.peak;
+    }
+
+    return result;
+}
 
+///////////////////////////////////////////////////////////////////////////////
+
+float
+SampledStat::quantile( float fraction ) const
+{
     const mstime_t now = process.mstime();
 
-    sample_t& s = *new sample_t;
-    s.value   = _fvalue;
-    s.elapsed = now - _lastSampleTime;
-    s.time    = now;
+    uint32 bins[HISTOGRAM_BINS];
+    memset( bins, 0, sizeof(bins) );
+
+    uint32 total  = 0;
+    uint32 result = 0;  // peak; no quantile exceeds it
+    for ( uint32 i = 0; i < _numBuckets; i++ ) {
+        const Bucket& b = _buckets[i];
+        if (!valid( b, now ))
+            continue;
+
+        for ( uint32 j = 0; j < HISTOGRAM_BINS; j++ )
+            bins[j] += b.bins[j];
+
+        total += b.count;
+        if (b.peak > result)
+            result = b.peak;
+    }
+
+    if (!total)
+        return 0.0f;
+
+    if (fraction < 0.0f)
+        fraction = 0.0f;
+    else if (fraction > 1.0f)
+        fraction = 1.0f;
 
-    if (s.elapsed < 0)
-        s.elapsed = 0;
+    // nearest rank
+    uint32 rank = uint32( ceil( double( fraction ) * total ));
+    if (rank < 1)
+        rank = 1;
 
-    _lastSampleTime = now;
+    uint32 seen = 0;
+    for ( uint32 j = 0; j < HISTOGRAM_BINS; j++ ) {
+        seen += bins[j];
+        if (seen < rank)
+            continue;
 
-    _samples.push_front( &s );
-    _samplesTotal.value   += s.value;
-    _samplesTotal.elapsed += s.elapsed;
+        const uint32 high = binHigh( j );
+        if (high < result)
+            result = high;
+        break;
+    }
 
-    const mstime_t oldest = now - _period;
-    while (!_samples.empty()) {
-        sample_t& back = *_samples.back();
+    return float( result );
+}
 
-        if (back.time > oldest)
-            break;
+///////////////////////////////////////////////////////////////////////////////
+
+float
+SampledStat::rate() const
+{
+    const mstime_t now  = process.mstime();
+    const mstime_t slot = now / _width;
 
-        _samplesTotal.value   -= back.value;
-        _samplesTotal.elapsed -= back.elapsed;
+    // Window begins at the start of the oldest bucket still inside it.
+    const mstime_t first = slot >= _numBuckets - 1 ? slot - (_numBuckets - 1) : 0;
+    const mstime_t span  = now - first * _width + 1;
 
-        _samples.pop_back();
-        delete &back;
+    double sum = 0.0;
+    for ( uint32 i = 0; i < _numBuckets; i++ ) {
+        if (valid( _buckets[i], now ))
+            sum += _buckets[i].sum;
     }
 
-    _avg = _samplesTotal.elapsed > 0
-        ? _samplesTotal.value / float(_samplesTotal.elapsed / 1000.0f)
-        : 0.0f;
+    return float( sum * 1000.0 / double( span ));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+SampledStat::reset()
+{
+    memset( _buckets, 0, _numBuckets * sizeof(Bucket) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+SampledStat::sample( float f )
+{
+    Bucket& b = current( process.mstime() );
+
+    b.sum += f;
+    b.count++;
+
+    uint32 value = 0;
+    if (f >= 4294967295.0f)
+        value = 0xffffffffU;
+    else if (f > 0.0f)
+        value = uint32( double( f ) + 0.5 );
+
+    if (value > b.peak)
+        b.peak = value;
+
+    b.bins[ binOf( value ) ]++;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -86,6 +236,15 @@ SampledStat::sample( int i )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool
+SampledStat::valid( const Bucket& b, mstime_t now ) const
+{
+    const mstime_t slot = now / _width;
+    return b.count && b.slot <= slot && b.slot + _numBuckets > slot;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 namespace stats {
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -94,6 +253,12 @@ SampledStat entitySpawn ( 15*1000 );
 SampledStat entityFree  ( 15*1000 );
 SampledStat frame       (  5*1000 );
 
+SampledStat antilagReconciled ( 5*1000 );
+SampledStat antilagSkipped    ( 5*1000 );
+SampledStat antilagGhosts     ( 5*1000 );
+
+SampledStat hitmodePose ( 5*1000 );
+
 ///////////////////////////////////////////////////////////////////////////////
 
 } // namespace stats
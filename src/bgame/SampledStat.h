@@ -3,37 +3,68 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ * SampledStat summarizes samples over a sliding window of the last period
+ * milliseconds.
+ *
+ * The window is a ring of fixed time buckets allocated at construction; a
+ * bucket is recycled when the clock moves a full period past it, so the
+ * window advances in steps of period/buckets and sampling never allocates.
+ * Each bucket keeps a sum, count, maximum and a log-linear histogram of
+ * values with HISTOGRAM_SUB bins per power of two (values below that are
+ * exact), so a quantile is within 1/HISTOGRAM_SUB of the true value.
+ *
+ * All queries cost O(buckets). Samples are rounded to whole numbers for the
+ * histogram; negative samples count as zero.
+ */
 class SampledStat
 {
 public:
     typedef Process::mstime_t mstime_t;
 
-private:
-    typedef struct sample_s {
-        float    value;
-        mstime_t elapsed;
-        mstime_t time;
-    } sample_t;
+    enum {
+        HISTOGRAM_BITS = 3,
+        HISTOGRAM_SUB  = 1 << HISTOGRAM_BITS,                    // bins per power of two
+        HISTOGRAM_BINS = (33 - HISTOGRAM_BITS) * HISTOGRAM_SUB,  // covers uint32
+    };
 
 private:
+    struct Bucket {
+        mstime_t slot;   // now / _width when bucket was last reset
+        double   sum;
+        uint32   count;
+        uint32   peak;
+        uint32   bins[HISTOGRAM_BINS];
+    };
+
     SampledStat(); // not permitted
 
-    mstime_t _period;
-    float    _fvalue;
-    int      _ivalue;
-    float    _avg;
+    const uint32   _numBuckets;
+    const mstime_t _width;    // milliseconds per bucket
+    Bucket* const  _buckets;
 
-    mstime_t        _lastSampleTime;
-    list<sample_t*> _samples;
-    sample_t        _samplesTotal;
+    Bucket& current ( mstime_t );                       // bucket for now, reset if stale
+    bool    valid   ( const Bucket&, mstime_t ) const;  // bucket is inside window ending now
+
+    static uint32 binOf   ( uint32 );  // histogram bin holding value
+    static uint32 binHigh ( uint32 );  // highest value held by bin
 
 public:
-    SampledStat( mstime_t );  // sample period in milliseconds
+    SampledStat( mstime_t, uint32 = 10 );  // period in milliseconds, number of buckets
     ~SampledStat();
 
-    float avg    ( );  // reeturns rate/s
-    void  sample ( float );
-    void  sample ( int   );
+    uint32 count    ( ) const;        // samples in window
+    float  mean     ( ) const;        // average sample value
+    uint32 peak     ( ) const;        // largest sample in window
+    float  quantile ( float ) const;  // value at fraction 0..1 of samples, eg: 0.99
+    float  rate     ( ) const;        // sum of samples per second
+    void   reset    ( );
+    void   sample   ( float );
+    void   sample   ( int   );
+
+private:
+    SampledStat( const SampledStat& );             // not copyable
+    SampledStat& operator=( const SampledStat& );
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -46,6 +77,12 @@ extern SampledStat entitySpawn;
 extern SampledStat entityFree;
 extern SampledStat frame;
 
+extern SampledStat antilagReconciled;
+extern SampledStat antilagSkipped;
+extern SampledStat antilagGhosts;
+
+extern SampledStat hitmodePose;  // usec spent computing hit-model poses
+
 ///////////////////////////////////////////////////////////////////////////////
 
 } // namespace stats
@@ -11,6 +11,7 @@ private:
 
 public:
     static void init   ( );
+    static void poll   ( );  // game: CVAR_JAYMODHOT variables plus a few others in turn
     static void update ( );
 
     static const list<Cvar*>& getUpdateList();
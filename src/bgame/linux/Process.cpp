@@ -11,7 +11,10 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <sys/time.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
 
 #ifdef _DEBUG
 #ifndef __USE_GNU
@@ -180,6 +183,61 @@ Process::mstime()
 
 //////////////////////////////////////////////////////////////////////////////
 
+Process::ustime_t
+Process::ustime()
+{
+    // Monotonic: intervals must not jump with NTP or date changes.
+    timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ustime_t( ts.tv_sec ) * ustime_t( 1000000 ) + ustime_t( ts.tv_nsec ) / ustime_t( 1000 );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+Process::fileSync( FILE* file )
+{
+    if (fflush( file ))
+        return true;
+
+    while (fsync( fileno( file ))) {
+        if (errno != EINTR)
+            return true;
+    }
+
+    return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+Process::fileReplace( const string& from, const string& to )
+{
+    return rename( from.c_str(), to.c_str() ) != 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+time_t
+Process::fileTime( const string& fname )
+{
+    struct stat st;
+    if (stat( fname.c_str(), &st ))
+        return 0;
+
+    return st.st_mtime;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+tm*
+Process::localtime( time_t t, tm& out )
+{
+    return localtime_r( &t, &out );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void
 Process::beginCriticalSection()
 {
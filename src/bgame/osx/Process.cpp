@@ -9,6 +9,10 @@
 #endif
 
 #include <sys/time.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <mach/mach_time.h>
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -47,3 +51,64 @@ Process::mstime()
     gettimeofday( &tv, 0 );
     return mstime_t( tv.tv_sec ) * mstime_t( 1000 ) + mstime_t( tv.tv_usec ) / mstime_t( 1000 );
 }
+
+//////////////////////////////////////////////////////////////////////////////
+
+Process::ustime_t
+Process::ustime()
+{
+    // Monotonic: intervals must not jump with NTP or date changes.
+    static mach_timebase_info_data_t timebase = { 0, 0 };
+    if (!timebase.denom)
+        mach_timebase_info( &timebase );
+
+    const ustime_t ticks = mach_absolute_time();
+
+    // Split to avoid overflow of ticks * numer.
+    const ustime_t scale = ustime_t( timebase.denom ) * ustime_t( 1000 );
+    return (ticks / scale) * ustime_t( timebase.numer )
+        + (ticks % scale) * ustime_t( timebase.numer ) / scale;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+Process::fileSync( FILE* file )
+{
+    if (fflush( file ))
+        return true;
+
+    // fsync() alone does not flush the drive cache on OS X.
+    if (fcntl( fileno( file ), F_FULLFSYNC ) != -1)
+        return false;
+
+    return fsync( fileno( file )) != 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+Process::fileReplace( const string& from, const string& to )
+{
+    return rename( from.c_str(), to.c_str() ) != 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+time_t
+Process::fileTime( const string& fname )
+{
+    struct stat st;
+    if (stat( fname.c_str(), &st ))
+        return 0;
+
+    return st.st_mtime;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+tm*
+Process::localtime( time_t t, tm& out )
+{
+    return localtime_r( &t, &out );
+}
@@ -912,6 +912,7 @@ default values.
 #define	CVAR_JAYMODINFO		16384	// marks variable as scanned for changes and CS_JAYMODINFO broadcast
 #define	CVAR_DELAYED		32768	// marks variable in cgame as delayed change
 #define	CVAR_JAYMODCB_INIT	65536	// causes callback to be invoked during game init
+#define	CVAR_JAYMODHOT		131072	// game polls variable every frame instead of in turn with others
 
 // nothing outside the Cvar_*() functions should modify these fields!
 typedef struct cvar_s {
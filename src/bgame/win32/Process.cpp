@@ -1,5 +1,8 @@
 #include <bgame/impl.h>
 #include <windows.h>
+#include <io.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -42,3 +45,57 @@ Process::mstime()
 
     return tmp.QuadPart / 10000;
 }
+
+//////////////////////////////////////////////////////////////////////////////
+
+Process::ustime_t
+Process::ustime()
+{
+    LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+    QueryPerformanceFrequency( &freq );
+    QueryPerformanceCounter( &count );
+
+    return ustime_t( count.QuadPart / freq.QuadPart ) * ustime_t( 1000000 )
+        + ustime_t( count.QuadPart % freq.QuadPart ) * ustime_t( 1000000 ) / ustime_t( freq.QuadPart );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+Process::fileSync( FILE* file )
+{
+    if (fflush( file ))
+        return true;
+
+    return _commit( _fileno( file )) != 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+Process::fileReplace( const string& from, const string& to )
+{
+    // rename() refuses to replace an existing file on Windows.
+    return !MoveFileExA( from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+time_t
+Process::fileTime( const string& fname )
+{
+    struct _stat st;
+    if (_stat( fname.c_str(), &st ))
+        return 0;
+
+    return st.st_mtime;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+tm*
+Process::localtime( time_t t, tm& out )
+{
+    return localtime_s( &out, &t ) ? NULL : &out;
+}
@@ -1334,7 +1334,7 @@ static void CG_DrawLagometer( void ) {
 
     // add snapshots/s in top-right corner of meter
     {
-        const int avg = int(stats::snapshot.avg() + 0.5f);
+        const int avg = int(stats::snapshot.rate() + 0.5f);
 
         vec4_t* color;
         if (avg < int(cvars::sv_fps.ivalue * 0.50f))
@@ -78,38 +78,59 @@ AbstractBulletModel::firePlayer( TraceContext& trx )
 bool
 AbstractBulletModel::fireWorld( TraceContext& trx )
 {
-    // TODO: nuke when done with scale testing
-    if (cvars::g_test.ivalue & G_TEST_SKIP_FIRE)
-        return false;
+    TraceContext* batch = &trx;
+    fireWorld( &batch, 1 );
+    return trx.hit;
+}
 
-    bool hit = fireWorldAtomic( trx, false );
+///////////////////////////////////////////////////////////////////////////////
 
-    if (trx.client && trx.client->bulletModel->_reference) {
-        TraceContext trx2 = trx;
-        fireWorldAtomic( trx2, true );
+void
+AbstractBulletModel::fireWorld( TraceContext** batch, int num )
+{
+    // TODO: nuke when done with scale testing
+    if (cvars::g_test.ivalue & G_TEST_SKIP_FIRE) {
+        for (int i = 0; i < num; i++)
+            batch[i]->hit = false;
+        return;
     }
 
-    return hit;
+    fireWorldAtomic( batch, num, false );
+
+    TraceContext& lead = *batch[0];
+    if (lead.client && lead.client->bulletModel->_reference) {
+        TraceBatch batch2;
+        for (int i = 0; i < num; i++)
+            batch2.add( *batch[i] );
+
+        fireWorldAtomic( batch2.list(), num, true );
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-bool
-AbstractBulletModel::fireWorldAtomic( TraceContext& trx, bool ref )
+void
+AbstractBulletModel::fireWorldAtomic( TraceContext** batch, int num, bool ref )
 {
     using namespace text;
 
     // Save debug size so we can discard if empty.
-    const uint32 savedDebugLength = trx.debug.length;
+    uint32 savedDebugLength[BATCH_MAX];
+
+    for (int i = 0; i < num; i++) {
+        TraceContext& trx = *batch[i];
+        savedDebugLength[i] = trx.debugLength();
+
+        if (!(cvars::g_bulletmodeDebug.ivalue & DEBUG_TFIRE))
+            continue;
 
-    if (cvars::g_bulletmodeDebug.ivalue & DEBUG_TFIRE) {
         InlineText colA;
 
         colA.flags |= ios::left;
         colA.width  = 13;
         colA.suffix = " = ";
 
-        trx.debug << xheaderBOLD( JAYMOD_FUNCTION ) << xlindent
+        trx.debug() << xheaderBOLD( JAYMOD_FUNCTION ) << xlindent
             << '\n' << colA( "source"        ) << xvalue ( trx.source.s.number )
             << '\n' << colA( "source.origin" ) << xvec3  ( trx.source.r.currentOrigin )
             << '\n' << colA( "actor"         ) << xvalue ( trx.actor.s.number )
@@ -120,19 +141,21 @@ AbstractBulletModel::fireWorldAtomic( TraceContext& trx, bool ref )
             << xlunindent << '\n';
     }
 
-    bool hit = AbstractHitModel::traceWorld( trx );
+    AbstractHitModel::traceWorld( batch, num );
+
+    for (int i = 0; i < num; i++) {
+        TraceContext& trx = *batch[i];
+        if (!trx.client)
+            continue;
 
-    if (trx.client) {
         if (ref)
             trx.client->bulletModel->_reference->firePlayer( trx );
         else
             trx.client->bulletModel->firePlayer( trx );
 
-        if (trx.debug.length > savedDebugLength)
-            trx.client->xprint( trx.debug );
+        if (trx.debugLength() > savedDebugLength[i])
+            trx.client->xprint( trx.debug() );
     }
-
-    return hit;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -15,7 +15,7 @@ class Client;
 class AbstractBulletModel : public NewAllocator<AbstractBulletModel>
 {
 private:
-    static bool fireWorldAtomic( TraceContext&, bool );
+    static void fireWorldAtomic( TraceContext**, int, bool );
 
 public:
     enum dflags_t {
@@ -40,11 +40,14 @@ public:
         _TYPE_MAX,
     };
 
+    enum { BATCH_MAX = TraceBatch::MAX };  // max contexts per fireWorld batch
+
     static void cvarTrail( Cvar& );
 
     static bool factory( AbstractBulletModel*&, Client&, type_t, bool );
 
     static bool fireWorld( TraceContext& );
+    static void fireWorld( TraceContext**, int );  // batch sharing source/actor/time
 
     static string  toString( dflags_t );
     static string& toString( dflags_t, string& );
@@ -5,6 +5,11 @@ namespace {
 ///////////////////////////////////////////////////////////////////////////////
 
 static list<AbstractHitModel*> __ghosts;
+static int                     __ghostsMaterialized;  // count for current frame
+
+static vector<AbstractHitModel*> __deferred;  // models whose pose is computed by runDeferred()
+static WorkerPool                __workers;
+static Process::ustime_t         __poseTime;  // usec spent posing models for current frame
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -13,18 +18,32 @@ static list<AbstractHitModel*> __ghosts;
 ///////////////////////////////////////////////////////////////////////////////
 
 AbstractHitModel::AbstractHitModel( type_t type_, Client& client_, vitality_t vitality_ )
-    : _visible       ( false )
-    , _reference     ( 0 )
-    , _time          ( -1 )
-    , _hitVolumeList ( )
-    , type           ( type_ )
-    , vitality       ( vitality_ )
-    , debug          ( string("hitModel[") + toString(type_) + "," + toString(vitality_) + "]", client_.debug )
-    , client         ( client_ )
-    , visible        ( _visible )
-    , time           ( _time )
-    , worldVol       ( AbstractHitVolume::_ZONE_UNDEFINED, *this, AbstractHitVolume::SCOPE_WORLD )
+    : _visible         ( false )
+    , _reference       ( 0 )
+    , _time            ( -1 )
+    , _snapshots       ( 0 )
+    , _snapshotPoses   ( 0 )
+    , _snapshotMax     ( 0 )
+    , _snapshotHead    ( 0 )
+    , _snapshotCount   ( 0 )
+    , _scratchModel    ( 0 )
+    , _contextHitModel ( 0 )
+    , _pending         ( false )
+    , _pendingLower    ( 0 )
+    , _pendingUpper    ( 0 )
+    , _pendingFraction ( 0.0f )
+    , _hitVolumeList   ( )
+    , type            ( type_ )
+    , vitality        ( vitality_ )
+    , debug           ( string("hitModel[") + toString(type_) + "," + toString(vitality_) + "]", client_.debug )
+    , client          ( client_ )
+    , visible         ( _visible )
+    , time            ( _time )
+    , worldVol        ( AbstractHitVolume::_ZONE_UNDEFINED, *this, AbstractHitVolume::SCOPE_WORLD )
 {
+    ClearBounds( _sweptBounds[0], _sweptBounds[1] );
+    memset( &_pose, 0, sizeof(_pose) );
+
     if (cvars::g_hitmodeDebug.ivalue & DEBUG_LIFECYCLE) {
         if (vitality == VITALITY_GHOST) {
             if (cvars::g_hitmodeDebug.ivalue & DEBUG_SNAPSHOT)
@@ -40,10 +59,9 @@ AbstractHitModel::AbstractHitModel( type_t type_, Client& client_, vitality_t vi
 
 AbstractHitModel::~AbstractHitModel()
 {
-    const list<AbstractHitModel*>::iterator end = _snapshots.end();
-    for ( list<AbstractHitModel*>::iterator it = _snapshots.begin(); it != end; it++ )
-        delete *it;
-
+    delete[] _snapshots;
+    delete[] _snapshotPoses;
+    delete _scratchModel;
     delete _reference;
 
     if (cvars::g_hitmodeDebug.ivalue & DEBUG_LIFECYCLE) {
@@ -108,6 +126,28 @@ AbstractHitModel::cvarGhosting( Cvar& var )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void
+AbstractHitModel::cvarLazy( Cvar& var )
+{
+    if (var.ivalue < 0)
+        var.set( 0 );
+    else if (var.ivalue > 1)
+        var.set( 1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::cvarThreads( Cvar& var )
+{
+    if (var.ivalue < 0)
+        var.set( 0 );
+    else if (var.ivalue > WorkerPool::WORKERS_MAX)
+        var.set( WorkerPool::WORKERS_MAX );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 AbstractHitModel::cvarZone( Cvar& var )
 {
@@ -117,6 +157,21 @@ AbstractHitModel::cvarZone( Cvar& var )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool
+AbstractHitModel::doCapture( grefEntity_t& )
+{
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::doPose( grefEntity_t& )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 AbstractHitVolume*
 AbstractHitModel::doTracePlayer( TraceContext& trx )
 {
@@ -188,6 +243,28 @@ AbstractHitModel::factory( AbstractHitModel*& result, Client& client, type_t typ
 
 ///////////////////////////////////////////////////////////////////////////////
 
+AbstractHitModel*
+AbstractHitModel::ghostAlloc()
+{
+    __ghostsMaterialized++;
+
+    if (cvars::g_hitmodeGhosting.ivalue) {
+        // Visualized ghosts must outlive the trace and are freed by ghostPrune().
+        AbstractHitModel* hm = doSnapshot();
+        __ghosts.push_front( hm );
+        return hm;
+    }
+
+    // Scratch ghost is only valid for the duration of a single trace,
+    // and is allocated once for lifetime of this model.
+    if (!_scratchModel)
+        _scratchModel = doSnapshot();
+
+    return _scratchModel;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 AbstractHitModel::ghostCleanup()
 {
@@ -201,6 +278,9 @@ AbstractHitModel::ghostCleanup()
 void
 AbstractHitModel::ghostPrune()
 {
+    stats::antilagGhosts.sample( __ghostsMaterialized );
+    __ghostsMaterialized = 0;
+
     const int cutoff = level.time - cvars::g_hitmodeGhosting.ivalue;
 
     while (!__ghosts.empty()) {
@@ -216,9 +296,17 @@ AbstractHitModel::ghostPrune()
 ///////////////////////////////////////////////////////////////////////////////
 
 void
-AbstractHitModel::lerp( AbstractHitModel& hmend, float fraction )
+AbstractHitModel::lerp( const snapshot_t& snapend, float fraction )
 {
-    worldVol.lerp( hmend.worldVol, fraction );
+    worldVol.lerp( snapend.world, fraction );
+
+    // Defer if either end has no volumes yet; see materialize().
+    if (_pending || snapend.pending) {
+        _pending         = true;
+        _pendingUpper    = &snapend;
+        _pendingFraction = fraction;
+        return;
+    }
 
     const list<AbstractHitVolume*>::iterator end = _hitVolumeList.end();
     for ( list<AbstractHitVolume*>::iterator it = _hitVolumeList.begin(); it != end; it++ ) {
@@ -226,7 +314,15 @@ AbstractHitModel::lerp( AbstractHitModel& hmend, float fraction )
         if (!(hv.flags & HVF_ENABLED))
             continue;
 
-        AbstractHitVolume* e = hmend.volumeForZone( hv.zone );
+        // First volume matching zone is used.
+        const AbstractHitVolume::record_t* e = 0;
+        for (int i = 0; i < snapend.numVolumes; i++) {
+            if (snapend.volumes[i].zone == hv.zone) {
+                e = &snapend.volumes[i];
+                break;
+            }
+        }
+
         if (!e)
             continue;
 
@@ -236,6 +332,63 @@ AbstractHitModel::lerp( AbstractHitModel& hmend, float fraction )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ * Bring volumes up to date if they were deferred by g_hitmodeLazy.
+ * Returns true if anything was computed, in which case worldVol has shrunk
+ * from its conservative bound to the exact one.
+ */
+bool
+AbstractHitModel::materialize()
+{
+    if (!_pending)
+        return false;
+
+    _pending = false;
+
+    if (vitality == VITALITY_PRINCIPAL) {
+        doPose( _pose );
+        updateWorldVol();
+        return true;
+    }
+
+    // Ghost: compute pending snapshots using this model as workspace,
+    // then replay the restore/lerp which was deferred.
+    const snapshot_t* const lower    = _pendingLower;
+    const snapshot_t* const upper    = _pendingUpper;
+    const float             fraction = _pendingFraction;
+
+    if (lower->pending)
+        materializeSnapshot( const_cast<snapshot_t&>( *lower ));
+    if (upper && upper->pending)
+        materializeSnapshot( const_cast<snapshot_t&>( *upper ));
+
+    restore( *lower );
+    if (upper)
+        lerp( *upper, fraction );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::materializeSnapshot( snapshot_t& snap )
+{
+    doPose( *snap.pose );
+    updateWorldVol();
+
+    worldVol.save( snap.world );
+
+    snap.numVolumes = 0;
+    const list<AbstractHitVolume*>::iterator end = _hitVolumeList.end();
+    for ( list<AbstractHitVolume*>::iterator it = _hitVolumeList.begin(); it != end && snap.numVolumes < SNAPSHOT_VOLUMES_MAX; it++ )
+        (*it)->save( snap.volumes[snap.numVolumes++] );
+
+    snap.pending = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 AbstractHitModel&
 AbstractHitModel::operator=( const AbstractHitModel& obj )
 {
@@ -256,6 +409,23 @@ AbstractHitModel::registerHitVolume( AbstractHitVolume& hv )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Link player into world using bounds of context (possibly historical) hit-model.
+void
+AbstractHitModel::reconcileBounds()
+{
+    VectorCopy( _contextHitModel->worldVol.mins, client.gentity.r.mins );
+    VectorSubtract( client.gentity.r.mins, client.gentity.r.currentOrigin, client.gentity.r.mins );
+
+    VectorCopy( _contextHitModel->worldVol.maxs, client.gentity.r.maxs );
+    VectorSubtract( client.gentity.r.maxs, client.gentity.r.currentOrigin, client.gentity.r.maxs );
+
+    if ( !(cvars::g_test.ivalue & G_TEST_SKIP_LINK) ) {
+        trap_LinkEntity( &client.gentity );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 AbstractHitModel::recordHit( AbstractHitVolume::zone_t z )
 {
@@ -273,43 +443,119 @@ AbstractHitModel::recordHit( AbstractHitVolume::zone_t z )
 ///////////////////////////////////////////////////////////////////////////////
 
 void
-AbstractHitModel::run()
+AbstractHitModel::restore( const snapshot_t& snap )
 {
-    snapshotPrune();
-    snapshot();  // must be before _time is set
+    _time = snap.time;
+    worldVol.restore( snap.world );
 
+    _pendingLower = &snap;
+    _pendingUpper = 0;
+
+    // Defer if snapshot has no volumes yet; see materialize().
+    _pending = snap.pending;
+    if (_pending)
+        return;
+
+    int i = 0;
+    const list<AbstractHitVolume*>::iterator end = _hitVolumeList.end();
+    for ( list<AbstractHitVolume*>::iterator it = _hitVolumeList.begin(); it != end && i < snap.numVolumes; it++, i++ )
+        (*it)->restore( snap.volumes[i] );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::run()
+{
     _time = level.time;
 
     updateVisibility();  // must be called before doRun()
-    doRun();
 
-    const list<AbstractHitVolume*>::iterator end = _hitVolumeList.end();
-    list<AbstractHitVolume*>::iterator it = _hitVolumeList.begin();
-    for ( ; it != end; it++ )
-        (*it)->entityCompute();
+    /* Lazy mode only captures the pose; volumes are computed when a trace reaches
+     * this player. Visible models are always computed so they can be drawn.
+     */
+    _pending = vitality == VITALITY_PRINCIPAL
+        && cvars::g_hitmodeLazy.ivalue
+        && !_visible
+        && doCapture( _pose );
+
+    if (_pending) {
+        const float reach = LAZY_RADIUS + fabs( cvars::g_hitmodeFat.fvalue );
+        for (int i = 0; i < 3; i++) {
+            worldVol.mins[i] = client.gentity.r.currentOrigin[i] - reach;
+            worldVol.maxs[i] = client.gentity.r.currentOrigin[i] + reach;
+        }
+    }
+    else if ( vitality == VITALITY_PRINCIPAL
+        && cvars::g_hitmodeThreads.ivalue
+        && !_visible
+        && doCapture( _pose ))
+    {
+        // Pose is computed on worker threads by runDeferred(), which then finishes.
+        __deferred.push_back( this );
+        return;
+    }
+    else {
+        const Process::ustime_t begin = process.ustime();
+        doRun();
+        updateWorldVol();
+        __poseTime += process.ustime() - begin;
+    }
 
-    ///////////////////////////////////////////////////////////////
-    //
-    // worldVol section
-    //
-    ///////////////////////////////////////////////////////////////
+    runFinish();
+}
 
-    // Update worldVol bounds.
-    // We assume there will always be at least one managed hit-volume.
-    it = _hitVolumeList.begin();
-    VectorCopy( (*it)->mins, worldVol.mins );
-    VectorCopy( (*it)->maxs, worldVol.maxs );
+///////////////////////////////////////////////////////////////////////////////
 
-    for ( it++; it != end; it++ ) {
-        AbstractHitVolume& hv = **it;
-        if (!(hv.flags & HVF_ENABLED))
-            continue;
+/*
+ * Compute poses of models queued by run() on g_hitmodeThreads workers.
+ * Posing is pure computation over per-client state, with pose buffers sized
+ * beforehand by mdx_pose_reserve(); everything engine-facing
+ * (entity updates, snapshot allocation, reference model) happens in runFinish()
+ * on this thread, in the same client order as serial mode.
+ */
+void
+AbstractHitModel::runDeferred()
+{
+    __workers.resize( cvars::g_hitmodeThreads.ivalue );
 
-        worldVol.expand( hv );
+    if (!__deferred.empty()) {
+        const Process::ustime_t begin = process.ustime();
+        mdx_pose_reserve();  // workers must not allocate pose buffers
+        __workers.run( runJob, &__deferred, int(__deferred.size()) );
+        __poseTime += process.ustime() - begin;
+
+        const vector<AbstractHitModel*>::iterator end = __deferred.end();
+        for ( vector<AbstractHitModel*>::iterator it = __deferred.begin(); it != end; it++ )
+            (*it)->runFinish();
+
+        __deferred.clear();
+    }
+
+    mdx_pose_verify();  // workers only flag DEBUG cross-check failures
+
+    stats::hitmodePose.sample( float(__poseTime) );
+    __poseTime = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::runFinish()
+{
+    if (!_pending) {
+        const list<AbstractHitVolume*>::iterator end = _hitVolumeList.end();
+        for ( list<AbstractHitVolume*>::iterator it = _hitVolumeList.begin(); it != end; it++ )
+            (*it)->entityCompute();
     }
 
     worldVol.entityCompute();
 
+    // Must be after worldVol is updated.
+    snapshot();
+    snapshotPrune();
+    updateSweptBounds();
+
     ///////////////////////////////////////////////////////////////
     //
     // reference model section
@@ -357,18 +603,114 @@ AbstractHitModel::run()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void
+AbstractHitModel::runJob( void* data, int index )
+{
+    AbstractHitModel& hm = *(*static_cast<vector<AbstractHitModel*>*>( data ))[index];
+    hm.doPose( hm._pose );
+    hm.updateWorldVol();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::runShutdown()
+{
+    __deferred.clear();
+    __workers.resize( 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 AbstractHitModel::snapshot()
 {
-    // Skip snapshot attempt before first run.
-    if (_time == -1)
+    if (vitality != VITALITY_PRINCIPAL)
         return;
 
-    if (cvars::g_hitmodeAntilag.ivalue < 1)
+    // History is only consulted for anti-lag; don't record any while it is off.
+    if (!cvars::g_hitmodeAntilag.ivalue) {
+        _snapshotHead  = 0;
+        _snapshotCount = 0;
         return;
+    }
 
-    _snapshots.push_front( doSnapshot() );
-    snapshotPrune();
+    if (!_snapshots) {
+        _snapshotMax = SNAPSHOT_INITIAL;
+        _snapshots = new snapshot_t[_snapshotMax];
+    }
+
+    // When full, drop what has aged out of the anti-lag window; if nothing
+    // has (long g_hitmodeAntilag or high sv_fps) grow rather than lose history.
+    if (_snapshotCount == _snapshotMax) {
+        snapshotPrune();
+        if (_snapshotCount == _snapshotMax)
+            snapshotGrow();
+    }
+
+    const int slot = (_snapshotHead + _snapshotCount) & (_snapshotMax - 1);
+    snapshot_t& snap = _snapshots[slot];
+    _snapshotCount++;
+
+    snap.time = _time;
+    worldVol.save( snap.world );
+
+    snap.pending = _pending;
+    if (_pending) {
+        if (!_snapshotPoses)
+            _snapshotPoses = new grefEntity_t[_snapshotMax];
+
+        _snapshotPoses[slot] = _pose;
+        snap.pose = &_snapshotPoses[slot];
+        snap.numVolumes = 0;
+        return;
+    }
+
+    snap.pose = 0;
+    snap.numVolumes = 0;
+    const list<AbstractHitVolume*>::iterator end = _hitVolumeList.end();
+    for ( list<AbstractHitVolume*>::iterator it = _hitVolumeList.begin(); it != end && snap.numVolumes < SNAPSHOT_VOLUMES_MAX; it++ )
+        (*it)->save( snap.volumes[snap.numVolumes++] );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const AbstractHitModel::snapshot_t&
+AbstractHitModel::snapshotAt( int index ) const
+{
+    return _snapshots[(_snapshotHead + index) & (_snapshotMax - 1)];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::snapshotGrow()
+{
+    const int capacity = _snapshotMax * 2;
+    snapshot_t* const snapshots = new snapshot_t[capacity];
+
+    grefEntity_t* const poses = _snapshotPoses ? new grefEntity_t[capacity] : 0;
+
+    // Unroll into oldest-first order.
+    for (int i = 0; i < _snapshotCount; i++) {
+        snapshot_t& snap = snapshots[i];
+        snap = snapshotAt( i );
+
+        if (snap.pose) {
+            poses[i] = *snap.pose;
+            snap.pose = &poses[i];
+        }
+    }
+
+    delete[] _snapshots;
+    delete[] _snapshotPoses;
+    _snapshots     = snapshots;
+    _snapshotPoses = poses;
+    _snapshotMax   = capacity;
+    _snapshotHead  = 0;
+
+    if (cvars::g_hitmodeDebug.ivalue & DEBUG_SNAPSHOT)
+        debug << "snapshot ring grown to " << capacity << " for " << cvars::g_hitmodeAntilag.ivalue << " msec" << endl;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -378,18 +720,62 @@ AbstractHitModel::snapshotPrune()
 {
     const int cutoff = level.time - cvars::g_hitmodeAntilag.ivalue;
 
-    while (!_snapshots.empty()) {
-        AbstractHitModel& hm = *_snapshots.back();
-        if (hm._time >= cutoff)
+    // Newest snapshot mirrors current state and is never pruned.
+    while (_snapshotCount > 1) {
+        if (snapshotAt( 0 ).time >= cutoff)
             break;
 
-        _snapshots.pop_back();
-        delete &hm;
+        _snapshotHead = (_snapshotHead + 1) & (_snapshotMax - 1);
+        _snapshotCount--;
     }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool
+AbstractHitModel::sweptIntersects( const TraceContext& trx )
+{
+    // Slab test of trace segment against swept bounds.
+    // A small epsilon guards against float error at box faces.
+    const float epsilon = 1.0f;
+
+    float tmin = 0.0f;
+    float tmax = 1.0f;
+
+    for (int i = 0; i < 3; i++) {
+        const float bmin = _sweptBounds[0][i] - epsilon;
+        const float bmax = _sweptBounds[1][i] + epsilon;
+        const float d    = trx.end[i] - trx.start[i];
+
+        if (d == 0.0f) {
+            if (trx.start[i] < bmin || trx.start[i] > bmax)
+                return false;
+            continue;
+        }
+
+        const float inv = 1.0f / d;
+        float t0 = (bmin - trx.start[i]) * inv;
+        float t1 = (bmax - trx.start[i]) * inv;
+        if (t0 > t1) {
+            const float tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+
+        if (t0 > tmin)
+            tmin = t0;
+        if (t1 < tmax)
+            tmax = t1;
+
+        if (tmin > tmax)
+            return false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 string
 AbstractHitModel::toString( dflags_t value )
 {
@@ -495,6 +881,8 @@ AbstractHitModel::toString( vitality_t value, string& out )
 bool
 AbstractHitModel::tracePlayer( TraceContext& trx )
 {
+    materialize();
+
     trx.hitvol = doTracePlayer( trx );
     if (!trx.hitvol)
         return false;
@@ -533,7 +921,7 @@ AbstractHitModel::tracePlayer( TraceContext& trx )
         colA.width = 14;
         colA.suffixOutside = " = ";
 
-        trx.debug << xheader( JAYMOD_FUNCTION ) << xlindent
+        trx.debug() << xheader( JAYMOD_FUNCTION ) << xlindent
             << "\n" << colA( "hit"     ) << xvalue( true )
             << "\n" << colA( "hv"      ) << xvalue( str::toString( trx.hitvol ))
             << "\n" << colA( "hv.type" ) << xvalue( AbstractHitVolume::toString( trx.hitvol->type ))
@@ -562,93 +950,86 @@ AbstractHitModel::tracePlayerBegin( TraceContext& trx )
 
         colB.width = 7;
 
-        trx.debug << xheaderBOLD( JAYMOD_FUNCTION ) << xlindent
+        trx.debug() << xheaderBOLD( JAYMOD_FUNCTION ) << xlindent
             << "\n" << colA( "trx.time" )    << colB( trx.time )
                     << " (" << xvalue( level.time - trx.time ) << " delta" << ")"
             << "\n" << colA( "client.slot" ) << colB( client.slot )
-                    << " (" << xvalue(_snapshots.size()) << " frames" << ")"
+                    << " (" << xvalue( _snapshotCount ) << " frames" << ")"
             << "\n" << colA( "level.time" )  << colB( level.time );
-    }
-
-    if (cvars::g_hitmodeAntilag.ivalue && trx.time < level.time) {
-        AbstractHitModel* hmUpper = _contextHitModel;
-        AbstractHitModel* hmLower = _contextHitModel;
-
-        int fi = 0; 
-        const list<AbstractHitModel*>::iterator end = _snapshots.end();
-        for ( list<AbstractHitModel*>::iterator it = _snapshots.begin(); it != end; it++, fi++ ) {
-            AbstractHitModel& hm = **it;
-
-            if (dbg)
-               trx.debug << "\n" << colA( fi ) << colB( hm._time );
 
-            if (trx.time < hm._time) { 
-                hmUpper = &hm;
-                continue;
-            }
+        for (int fi = 0; fi < _snapshotCount; fi++)
+            trx.debug() << "\n" << colA( fi ) << colB( snapshotAt( _snapshotCount - 1 - fi ).time );
+    }
 
-            hmLower = &hm;
-            break;
+    if (cvars::g_hitmodeAntilag.ivalue && trx.time < level.time && _snapshotCount) {
+        // Binary search for oldest snapshot newer than trx.time.
+        int lo = 0;
+        int hi = _snapshotCount - 1;  // newest is current state, always a candidate
+        while (lo < hi) {
+            const int mid = (lo + hi) / 2;
+            if (snapshotAt( mid ).time > trx.time)
+                hi = mid;
+            else
+                lo = mid + 1;
         }
 
-        if (hmLower->_time > hmUpper->_time)
-            hmLower = hmUpper;
+        const int iupper = lo;
+        const int ilower = (lo > 0 && snapshotAt( lo ).time > trx.time) ? lo - 1 : lo;
+
+        const snapshot_t& upper = snapshotAt( iupper );
+        const snapshot_t& lower = snapshotAt( ilower );
 
         if (dbg) {
-            trx.debug << "\n" << colA( "upper.frameTime" ) << colB( hmUpper->_time )
-                      << "\n" << colA( "lower.frameTime" ) << colB( hmLower->_time );
+            trx.debug() << "\n" << colA( "upper.frameTime" ) << colB( upper.time )
+                      << "\n" << colA( "lower.frameTime" ) << colB( lower.time );
         }
 
-        if (hmLower->_time == hmUpper->_time) {
-            if (_time != hmUpper->_time) {
+        if (ilower == iupper) {
+            if (iupper != _snapshotCount - 1) {
                 // We have exact snapshot, no lerp required.
-                _contextHitModel = hmUpper;
+                _contextHitModel = ghostAlloc();
+                _contextHitModel->restore( upper );
 
                 if (dbg)
-                    trx.debug << "\n" << colA( "snap.exact" ) << colB( _contextHitModel->_time );
+                    trx.debug() << "\n" << colA( "snap.exact" ) << colB( _contextHitModel->_time );
             }
             else {
                 // We will be using the most recent frame.
                 if (dbg)
-                    trx.debug << "\n" << colA( "snap.none" ) << colB( _contextHitModel->_time );
+                    trx.debug() << "\n" << colA( "snap.none" ) << colB( _contextHitModel->_time );
             }
         }
         else if (cvars::g_hitmodeAntilagLerp.ivalue) {
             // LERP enabled.
-            _contextHitModel = hmLower->doSnapshot();
-            __ghosts.push_front( _contextHitModel );
-            _contextHitModel->lerp( *hmUpper,
-                float(trx.time - hmLower->_time) / float(hmUpper->_time - hmLower->_time) );
+            _contextHitModel = ghostAlloc();
+            _contextHitModel->restore( lower );
+            _contextHitModel->lerp( upper,
+                float(trx.time - lower.time) / float(upper.time - lower.time) );
 
             if (dbg) {
-                trx.debug << "\n" << colA( "snap.lerp" )
-                                  << colB( _contextHitModel->_time ) << " --> " << colB( hmUpper->_time );
+                trx.debug() << "\n" << colA( "snap.lerp" )
+                                  << colB( _contextHitModel->_time ) << " --> " << colB( upper.time );
             }
         }
         else {
             // LERP disabled.
-            _contextHitModel = hmUpper;
+            if (iupper != _snapshotCount - 1) {
+                _contextHitModel = ghostAlloc();
+                _contextHitModel->restore( upper );
+            }
 
             if (dbg)
-                trx.debug << "\n" << colA( "snap.exact" ) << colB( _contextHitModel->_time );
+                trx.debug() << "\n" << colA( "snap.exact" ) << colB( _contextHitModel->_time );
         }
     }
 
     VectorCopy( client.gentity.r.mins, _originalBounds[0] );
     VectorCopy( client.gentity.r.maxs, _originalBounds[1] );
 
-    VectorCopy( _contextHitModel->worldVol.mins, client.gentity.r.mins );
-    VectorSubtract( client.gentity.r.mins, client.gentity.r.currentOrigin, client.gentity.r.mins );
-
-    VectorCopy( _contextHitModel->worldVol.maxs, client.gentity.r.maxs );
-    VectorSubtract( client.gentity.r.maxs, client.gentity.r.currentOrigin, client.gentity.r.maxs );
-
-    if ( !(cvars::g_test.ivalue & G_TEST_SKIP_LINK) ) {
-        trap_LinkEntity( &client.gentity );
-    }
+    reconcileBounds();
 
     if ( dbg ) {
-        trx.debug
+        trx.debug()
             << "\n" << colA( "original.mins" ) << xvec3( _originalBounds[0] )
             << "\n" << colA( "original.maxs" ) << xvec3( _originalBounds[1] )
             << "\n" << colA( "r.mins" )        << xvec3( client.gentity.r.mins )
@@ -674,12 +1055,26 @@ if (!(cvars::g_test.ivalue & G_TEST_SKIP_LINK))
 bool
 AbstractHitModel::traceWorld( TraceContext& trx )
 {
+    TraceContext* batch = &trx;
+    traceWorld( &batch, 1 );
+    return trx.hit;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::traceWorld( TraceContext** batch, int num )
+{
+    // All contexts in a batch share source, actor and time; lead is used for reconciliation.
+    TraceContext& lead = *batch[0];
+
     // List of flags indicating if client was reconciled.
     bitset<MAX_CLIENTS> reconciled;
     bitset<MAX_CLIENTS> unlinked;
+    int numSkipped = 0;
 
     // Ready players in world for trace.
-    const bool antilag = trx.client && cvars::g_hitmodeAntilag.ivalue && trx.client->gclient.pers.antilag;
+    const bool antilag = lead.client && cvars::g_hitmodeAntilag.ivalue && lead.client->gclient.pers.antilag;
     for (int i = 0; i < MAX_CLIENTS; i++) {
         Client& client = g_clientObjects[i];
 
@@ -692,53 +1087,90 @@ AbstractHitModel::traceWorld( TraceContext& trx )
             continue;
 
         // Skip self.
-        if (trx.client->slot == client.slot)
+        if (lead.client->slot == client.slot)
             continue;
 
         if (!client.isReconcileSafe())
             continue;
 
+        // Broad-phase: any snapshot (or lerp between two) lies within swept bounds,
+        // so if every ray misses those bounds then reconciliation cannot produce a hit.
+        bool near = false;
+        for (int ri = 0; ri < num && !near; ri++)
+            near = client.hitModel->sweptIntersects( *batch[ri] );
+
+        if (!near) {
+            numSkipped++;
+            continue;
+        }
+
         reconciled.set( client.slot );
-        client.hitModel->tracePlayerBegin( trx );
+        client.hitModel->tracePlayerBegin( lead );
+    }
+
+    if (antilag) {
+        stats::antilagReconciled.sample( int(reconciled.count()) );
+        stats::antilagSkipped.sample( numSkipped );
     }
 
     // Remove self from world tracing to prevent shooting self.
-    if (trx.client && trx.client->gentity.r.linked) {
-        unlinked.set( trx.client->slot );
-        trap_UnlinkEntity( &trx.client->gentity );
+    if (lead.client && lead.client->gentity.r.linked) {
+        unlinked.set( lead.client->slot );
+        trap_UnlinkEntity( &lead.client->gentity );
     }
 
-    // Bullet might hit world-volume player, and then miss all sub-volumes.
-    // Since this is very likely (eg. shoot between player's legs and hit player on other side)
-    // it is important for us to continue the trace. Our strategy will be to unlink player,
-    // and repeat. However, the theoretical limit of this is MAX_CLIENTS, and just to be
-    // safe we'll limit the number of near-misses accordingly.
+    for (int ri = 0; ri < num; ri++) {
+        TraceContext& trx = *batch[ri];
 
-    bool hit = false;
-    for (int wi = 0; wi < MAX_CLIENTS; wi++) {
-        // Check for hit against aa-bbox (worldVol).
-        hit = trx.trace( JAYMOD_FUNCTION, wi );
+        // Bullet might hit world-volume player, and then miss all sub-volumes.
+        // Since this is very likely (eg. shoot between player's legs and hit player on other side)
+        // it is important for us to continue the trace. Our strategy will be to unlink player,
+        // and repeat. However, the theoretical limit of this is MAX_CLIENTS, and just to be
+        // safe we'll limit the number of near-misses accordingly.
 
-        // No need to continue if we scored no hit.
-        if (!hit)
-            break;
+        bitset<MAX_CLIENTS> missed;
 
-        // No need to continue if hit was not player.
-        if (!trx.resultIsPlayer())
-            break;
+        // Each player may also force one retrace when its lazy volumes are computed.
+        trx.hit = false;
+        for (int wi = 0; wi < MAX_CLIENTS*2; wi++) {
+            // Check for hit against aa-bbox (worldVol).
+            trx.hit = trx.trace( JAYMOD_FUNCTION, wi );
 
-        // Perform sub-volumes hit tracing.
-        Client& client = g_clientObjects[trx.data.entityNum];
-        hit = client.hitModel->_contextHitModel->tracePlayer( trx );
+            // No need to continue if we scored no hit.
+            if (!trx.hit)
+                break;
 
-        // Sub-volume hit means we do not need to handle near-miss situation.
-        if (hit)
-            break;
+            // No need to continue if hit was not player.
+            if (!trx.resultIsPlayer())
+                break;
+
+            Client& client = g_clientObjects[trx.data.entityNum];
+
+            // Reconciled bounds of lazy hit-model were conservative; now that volumes are
+            // computed, relink with exact bounds and retrace so results match eager mode.
+            if (client.hitModel->_contextHitModel->materialize() && reconciled[client.slot]) {
+                client.hitModel->reconcileBounds();
+                continue;
+            }
+
+            // Perform sub-volumes hit tracing.
+            trx.hit = client.hitModel->_contextHitModel->tracePlayer( trx );
 
-        // Bullet missed all sub-volumes so unlink if linked, and retry.
-        if (client.gentity.r.linked) {
-            unlinked.set( client.slot );
-            trap_UnlinkEntity( &client.gentity );
+            // Sub-volume hit means we do not need to handle near-miss situation.
+            if (trx.hit)
+                break;
+
+            // Bullet missed all sub-volumes so unlink if linked, and retry.
+            if (client.gentity.r.linked) {
+                missed.set( client.slot );
+                trap_UnlinkEntity( &client.gentity );
+            }
+        }
+
+        // Near-misses only apply to this ray; relink for the next one.
+        for (int i = 0; i < MAX_CLIENTS; i++) {
+            if (missed[i])
+                trap_LinkEntity( &g_clientObjects[i].gentity );
         }
     }
 
@@ -746,7 +1178,7 @@ AbstractHitModel::traceWorld( TraceContext& trx )
     if (antilag) {
         for (int i = 0; i < MAX_CLIENTS; i++) {
             if (reconciled[i])
-                g_clientObjects[i].hitModel->tracePlayerEnd( trx );
+                g_clientObjects[i].hitModel->tracePlayerEnd( lead );
         }
     }
 
@@ -755,8 +1187,42 @@ AbstractHitModel::traceWorld( TraceContext& trx )
         if (unlinked[i])
             trap_LinkEntity( &g_clientObjects[i].gentity );
     }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::updateSweptBounds()
+{
+    VectorCopy( worldVol.mins, _sweptBounds[0] );
+    VectorCopy( worldVol.maxs, _sweptBounds[1] );
+
+    for (int i = 0; i < _snapshotCount; i++) {
+        const snapshot_t& snap = snapshotAt( i );
+        AddPointToBounds( snap.world.mins, _sweptBounds[0], _sweptBounds[1] );
+        AddPointToBounds( snap.world.maxs, _sweptBounds[0], _sweptBounds[1] );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitModel::updateWorldVol()
+{
+    // Update worldVol bounds.
+    // We assume there will always be at least one managed hit-volume.
+    const list<AbstractHitVolume*>::iterator end = _hitVolumeList.end();
+    list<AbstractHitVolume*>::iterator it = _hitVolumeList.begin();
+    VectorCopy( (*it)->mins, worldVol.mins );
+    VectorCopy( (*it)->maxs, worldVol.maxs );
 
-    return hit;
+    for ( it++; it != end; it++ ) {
+        AbstractHitVolume& hv = **it;
+        if (!(hv.flags & HVF_ENABLED))
+            continue;
+
+        worldVol.expand( hv );
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -802,18 +1268,3 @@ AbstractHitModel::updateVisibility()
         worldVol.entityFree();
     }
 }
-
-///////////////////////////////////////////////////////////////////////////////
-
-AbstractHitVolume*
-AbstractHitModel::volumeForZone( AbstractHitVolume::zone_t z )
-{
-    const list<AbstractHitVolume*>::iterator end = _hitVolumeList.end();
-    for ( list<AbstractHitVolume*>::iterator it = _hitVolumeList.begin(); it != end; it++ ) {
-        AbstractHitVolume& hv = **it;
-        if (hv.zone == z)
-            return &hv;
-    }
-
-    return 0;
-}
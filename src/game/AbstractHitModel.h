@@ -58,12 +58,17 @@ public:
     static void cvarAntilagLerp ( Cvar& );  // cvar-changed callback
     static void cvarFat         ( Cvar& );  // cvar-changed callback
     static void cvarGhosting    ( Cvar& );  // cvar-changed callback
+    static void cvarLazy        ( Cvar& );  // cvar-changed callback
+    static void cvarThreads     ( Cvar& );  // cvar-changed callback
     static void cvarZone        ( Cvar& );  // cvar-changed callback
 
     static bool factory      ( AbstractHitModel*&, Client&, type_t, vitality_t );
     static void ghostCleanup ( );  // Invoked from GAME_SHUTDOWN.
     static void ghostPrune   ( );  // Invoked from GAME_RUNFRAME.
+    static void runDeferred  ( );  // Invoked from GAME_RUNFRAME after all clients have run.
+    static void runShutdown  ( );  // Invoked from GAME_SHUTDOWN.
     static bool traceWorld   ( TraceContext& );
+    static void traceWorld   ( TraceContext**, int );  // batch sharing source/actor/time
 
     static string  toString ( dflags_t );
     static string& toString ( dflags_t, string& );
@@ -73,30 +78,89 @@ public:
     static string& toString ( vitality_t, string& );
 
 private:
-    AbstractHitModel();
+    enum {
+        SNAPSHOT_INITIAL     = 64,  // initial ring capacity, must be power of 2
+        SNAPSHOT_VOLUMES_MAX = 12,  // max hit-volumes per model
+
+        LAZY_RADIUS = 128,  // conservative reach of any hit-volume from player origin
+    };
 
-    void lerp             ( AbstractHitModel&, float );
-    void recordHit        ( AbstractHitVolume::zone_t );
-    void snapshot         ( );
-    void snapshotPrune    ( );
-    void tracePlayerBegin ( TraceContext& );
-    void tracePlayerEnd   ( TraceContext& );
-    void updateVisibility ( );
+    // Compact POD record of hit-model state used for anti-lag history.
+    // A pending snapshot holds only a conservative world record and points at its
+    // captured pose in _snapshotPoses; volumes are computed from the pose when a
+    // trace first needs them.
+    typedef struct snapshot_s {
+        int                         time;
+        AbstractHitVolume::record_t world;
+        int                         numVolumes;
+        AbstractHitVolume::record_t volumes[SNAPSHOT_VOLUMES_MAX];
+        bool                        pending;
+        grefEntity_t*               pose;  // NULL unless pending
+    } snapshot_t;
 
-    AbstractHitVolume* volumeForZone( AbstractHitVolume::zone_t );
+    AbstractHitModel();
+
+    AbstractHitModel* ghostAlloc ( );  // ghost to restore snapshot into for a single trace
+
+    void lerp                ( const snapshot_t&, float );
+    bool materialize         ( );
+    void materializeSnapshot ( snapshot_t& );
+    void reconcileBounds     ( );
+    void recordHit           ( AbstractHitVolume::zone_t );
+    void restore             ( const snapshot_t& );
+    void runFinish           ( );
+    void snapshot            ( );
+    void snapshotGrow        ( );
+    void snapshotPrune       ( );
+    bool sweptIntersects     ( const TraceContext& );
+    void tracePlayerBegin    ( TraceContext& );
+    void tracePlayerEnd      ( TraceContext& );
+    void updateSweptBounds   ( );
+    void updateVisibility    ( );
+    void updateWorldVol      ( );
+
+    const snapshot_t& snapshotAt( int ) const;  // 0 is oldest
+
+    static void runJob( void*, int );  // WorkerPool job: pose one deferred model
 
     bool              _visible;
     AbstractHitModel* _reference;
     int               _time;      // Server time when run().
 
-    list<AbstractHitModel*> _snapshots;  // History of AHM anti-lag snapshots.
+    // History of anti-lag snapshots ordered oldest to newest, where newest
+    // is always the state computed by the most recent run().
+    // Allocated on first use and only for PRINCIPAL models with anti-lag enabled,
+    // and doubled whenever the whole ring is still inside the anti-lag window.
+    // Poses of pending snapshots live in a parallel ring of the same capacity,
+    // allocated only once g_hitmodeLazy first leaves a snapshot pending.
+    snapshot_t*       _snapshots;
+    grefEntity_t*     _snapshotPoses;
+    int               _snapshotMax;  // ring capacity, power of 2
+    int               _snapshotHead;
+    int               _snapshotCount;
+    AbstractHitModel* _scratchModel;  // reusable ghost which snapshots are restored/lerped into
+
+    // Union of worldVol bounds over current frame and all snapshots.
+    // Used as broad-phase to skip reconciliation of clients nowhere near a trace.
+    vec3_t _sweptBounds[2];
 
     vec3_t            _originalBounds[2];
     AbstractHitModel* _contextHitModel;
 
+    // Lazy hit-volumes (g_hitmodeLazy): when pending, volumes are stale and worldVol is
+    // only a conservative bound. PRINCIPAL models compute from _pose; ghosts replay
+    // restore of _pendingLower and optional lerp to _pendingUpper.
+    bool              _pending;
+    grefEntity_t      _pose;
+    const snapshot_t* _pendingLower;
+    const snapshot_t* _pendingUpper;
+    float             _pendingFraction;
+
 protected:
     AbstractHitModel( type_t, Client&, vitality_t );
 
+    virtual bool               doCapture     ( grefEntity_t& );  // true if model supports lazy volumes
+    virtual void               doPose        ( grefEntity_t& );
     virtual void               doRun         ( ) = 0;
     virtual AbstractHitModel*  doSnapshot    ( ) = 0;
     virtual AbstractHitVolume* doTracePlayer ( TraceContext& );
@@ -120,7 +120,7 @@ AbstractHitVolume::expand( const AbstractHitVolume& vol )
 ///////////////////////////////////////////////////////////////////////////////
 
 void
-AbstractHitVolume::lerp( AbstractHitVolume& end, float fraction )
+AbstractHitVolume::lerp( const record_t& end, float fraction )
 {
     __fastLerp( mins, end.mins, fraction, mins );
     __fastLerp( maxs, end.maxs, fraction, maxs );
@@ -151,6 +151,27 @@ AbstractHitVolume::recordHit()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void
+AbstractHitVolume::restore( const record_t& rec )
+{
+    _flags = rec.flags;
+    VectorCopy( rec.mins, mins );
+    VectorCopy( rec.maxs, maxs );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AbstractHitVolume::save( record_t& rec ) const
+{
+    rec.zone  = zone;
+    rec.flags = _flags;
+    VectorCopy( mins, rec.mins );
+    VectorCopy( maxs, rec.maxs );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 AbstractHitVolume::set( hitVolumeFlags_t f, bool on )
 {
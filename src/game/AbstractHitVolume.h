@@ -75,6 +75,18 @@ public:
     static string  toString( zone_t );
     static string& toString( zone_t, string& );
 
+    // Compact POD record of volume state used by hit-model anti-lag history.
+    // Transform fields are only meaningful for oriented volumes.
+    typedef struct record_s {
+        zone_t zone;
+        int    flags;
+        vec3_t mins;
+        vec3_t maxs;
+        vec3_t origin;
+        vec3_t scale;
+        vec3_t axis[3];
+    } record_t;
+
 protected:
     AbstractHitVolume( type_t, zone_t, entityType_t, AbstractHitModel&, scope_t );
 
@@ -91,11 +103,14 @@ public:
 
     virtual bool castRay( TraceContext&, vec3_t&, float& ) = 0;
 
+    virtual void restore ( const record_t& );
+    virtual void save    ( record_t& ) const;
+
     void entityAlloc   ( );
     void entityCompute ( );
     void entityFree    ( );
     void expand        ( const AbstractHitVolume& );
-    void lerp          ( AbstractHitVolume&, float );
+    void lerp          ( const record_t&, float );
     void recordHit     ( );
     void set           ( hitVolumeFlags_t );
     void set           ( hitVolumeFlags_t, bool );
@@ -51,13 +51,19 @@ AdvancedHitModel::~AdvancedHitModel()
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void
-AdvancedHitModel::doRun()
+bool
+AdvancedHitModel::doCapture( grefEntity_t& re )
 {
-    // Fetch origins/orientations for player model.   
-    grefEntity_t re;
     mdx_gentity_to_grefEntity( &client.gentity, &re, time );
+    return true;
+}
 
+///////////////////////////////////////////////////////////////////////////////
+
+void
+AdvancedHitModel::doPose( grefEntity_t& re )
+{
+    // Fetch origins/orientations for player model.
     vec3_t        origins[MRP_MAX];
     orientation_t orients[MRP_MAX];
     mdx_advanced_positions( client.gentity, re, origins, orients );
@@ -227,6 +233,16 @@ AdvancedHitModel::doRun()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void
+AdvancedHitModel::doRun()
+{
+    grefEntity_t re;
+    doCapture( re );
+    doPose( re );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 AdvancedHitModel&
 AdvancedHitModel::operator=( const AdvancedHitModel& obj )
 {
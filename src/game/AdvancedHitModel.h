@@ -14,6 +14,8 @@ private:
     AdvancedHitModel();
 
 protected:
+    bool              doCapture  ( grefEntity_t& );
+    void              doPose     ( grefEntity_t& );
     void              doRun      ( );
     AdvancedHitModel* doSnapshot ( );
 
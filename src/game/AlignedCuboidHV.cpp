@@ -18,6 +18,15 @@ AlignedCuboidHV::~AlignedCuboidHV()
 bool
 AlignedCuboidHV::castRay( TraceContext& trx, vec3_t& rpos, float& rlen )
 {
+    // Broad-phase: skip the 6 plane tests when the ray cannot touch this volume.
+    // Not applied while debugging this zone so per-face output remains complete.
+    const bool doDebug =
+        (cvars::g_hitmodeDebug.ivalue & AbstractHitModel::DEBUG_TVOLUME) &&
+        (cvars::g_hitmodeZone.ivalue == zone);
+
+    if (!doDebug && !segmentIntersects( trx ))
+        return false;
+
     vec3_t quad[4];
 
     vec3_t tmppos;
@@ -99,7 +108,7 @@ AlignedCuboidHV::castRayPlane(
     TraceContext&  trx,
     vec3_t         rpos,
     float&         rlen,
-    const string&  name,
+    const char*    name,
     vec3_t*        quad,
     int            iboundx,
     int            iboundy )
@@ -138,7 +147,7 @@ AlignedCuboidHV::castRayPlane(
         colA.width = 9;
         colA.suffixOutside = " = ";
 
-        trx.debug << xheader( JAYMOD_FUNCTION )
+        trx.debug() << xheader( JAYMOD_FUNCTION )
             << "\n(" << xcpush << xcheader << " zone=" << xvalueBOLD( toString( zone ))
                                            << " type=" << xvalueBOLD( toString( type ))
                                            << " face=" << xvalueBOLD( name )
@@ -163,7 +172,7 @@ AlignedCuboidHV::castRayPlane(
     // Prune if start point is on backside of face.
     if (rstart > 0) {
         if (doDebug) {
-            trx.debug << "\n" << colA( "pruned" ) << xvalue( "back-side of plane" )
+            trx.debug() << "\n" << colA( "pruned" ) << xvalue( "back-side of plane" )
                       << xlunindent << "\n";
         }
         return false;
@@ -174,12 +183,12 @@ AlignedCuboidHV::castRayPlane(
     float rend = DotProduct( facen, trx.end   ) + dist;
 
     if (doDebug)
-        trx.debug << "\n" << colA( "rend" ) << xvalue( rend );
+        trx.debug() << "\n" << colA( "rend" ) << xvalue( rend );
 
     // Prune if both points are on same side of plane.
     if ( (rstart < 0 && rend < 0) || (rstart > 0 && rend > 0) ) {
         if (doDebug) {
-            trx.debug << "\n" << colA( "pruned" ) << xvalue( "never crosses plane" )
+            trx.debug() << "\n" << colA( "pruned" ) << xvalue( "never crosses plane" )
                       << xlunindent << "\n";
         }
         return false;
@@ -188,11 +197,11 @@ AlignedCuboidHV::castRayPlane(
     // Compute intersection point of infinite line on infinite plane.
     float denom = facen[0]*ptray[0] + facen[1]*ptray[1] + facen[2]*ptray[2];
     if (doDebug)
-        trx.debug << "\n" << colA( "denom" ) << xvalue( denom );
+        trx.debug() << "\n" << colA( "denom" ) << xvalue( denom );
 
     if (denom == 0) {
         if (doDebug) {
-            trx.debug << "\n" << colA( "pruned" ) << xvalue( "denom != 0" )
+            trx.debug() << "\n" << colA( "pruned" ) << xvalue( "denom != 0" )
                       << xlunindent << "\n";
         }
         return false;
@@ -200,12 +209,12 @@ AlignedCuboidHV::castRayPlane(
 
     float mu = -( dist + DotProduct( facen, trx.start )) / denom;
     if (doDebug)
-        trx.debug << "\n" << colA( "mu" ) << xvalue( mu );
+        trx.debug() << "\n" << colA( "mu" ) << xvalue( mu );
 
     // Prune if no intersect point.
     if (mu < 0 || mu > 1) {
         if (doDebug) {
-            trx.debug << "\n" << colA( "pruned" ) << xvalue( "no intersect" )
+            trx.debug() << "\n" << colA( "pruned" ) << xvalue( "no intersect" )
                       << xlunindent << "\n";
         }
         return false;
@@ -222,7 +231,7 @@ AlignedCuboidHV::castRayPlane(
 
     if (!hit) {
         if (doDebug) {
-            trx.debug << "\n" << colA( "pruned" ) << xvalue( "not inside face" )
+            trx.debug() << "\n" << colA( "pruned" ) << xvalue( "not inside face" )
                       << xlunindent << "\n";
         }
         return false;
@@ -234,7 +243,7 @@ AlignedCuboidHV::castRayPlane(
 
     if (doDebug) {
         colA.color = xcdebugBOLD;
-        trx.debug << "\n" << colA( "rlen" ) << xvalue( rlen )
+        trx.debug() << "\n" << colA( "rlen" ) << xvalue( rlen )
                   << "\n" << colA( "rpos" ) << xvec3 ( rpos )
                   << xlunindent << "\n";
     }
@@ -244,6 +253,53 @@ AlignedCuboidHV::castRayPlane(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ * Conservative slab test of the trx segment against mins/maxs.
+ * Bounds are padded so float error can never reject a ray which the plane
+ * tests would accept; a false result guarantees castRay misses.
+ */
+bool
+AlignedCuboidHV::segmentIntersects( const TraceContext& trx ) const
+{
+    float tmin = 0.0f;
+    float tmax = 1.0f;
+
+    for (int k = 0; k < 3; k++) {
+        const float pad = 0.01f * (maxs[k] - mins[k]) + 0.25f;
+        const float lo  = mins[k] - pad;
+        const float hi  = maxs[k] + pad;
+
+        const float p = trx.start[k];
+        const float d = trx.end[k] - trx.start[k];
+
+        if (d == 0.0f) {
+            if (p < lo || p > hi)
+                return false;
+            continue;
+        }
+
+        float t0 = (lo - p) / d;
+        float t1 = (hi - p) / d;
+        if (t0 > t1) {
+            const float tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+
+        if (t0 > tmin)
+            tmin = t0;
+        if (t1 < tmax)
+            tmax = t1;
+
+        if (tmin > tmax)
+            return false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 AlignedCuboidHV::doEntityCompute()
 {
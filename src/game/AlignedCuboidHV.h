@@ -10,11 +10,13 @@ protected:
         TraceContext&,  // standard trace context
         vec3_t,         // result: position of hit
         float&,         // result: length of hit-ray
-        const string&,  // name of face/plane
+        const char*,    // name of face/plane
         vec3_t*,        // 4 verts defining in mins/maxs order
         int,            // which of 3-dims used for x-bounds check
         int );          // which of 3-dims used for y-bounds check
 
+    bool segmentIntersects( const TraceContext& ) const;
+
     void doEntityCompute();
 
 public:
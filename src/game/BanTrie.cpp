@@ -0,0 +1,382 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Parse decimal octet at p, advancing p. Returns true on error.
+bool
+parseOctet( const char*& p, uint32& octet )
+{
+    if (*p < '0' || *p > '9')
+        return true;
+
+    octet = 0;
+    for ( int digits = 0; *p >= '0' && *p <= '9'; p++ ) {
+        if (++digits > 3)
+            return true;
+        octet = octet * 10 + (*p - '0');
+    }
+
+    return octet > 255;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Parse "a.b.c.d" at p, advancing p. Returns true on error.
+bool
+parseQuad( const char*& p, uint32& address )
+{
+    address = 0;
+    for ( int i = 0; i < 4; i++ ) {
+        if (i > 0 && *p++ != '.')
+            return true;
+
+        uint32 octet;
+        if (parseOctet( p, octet ))
+            return true;
+
+        address = (address << 8) | octet;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+BanTrie::Node::Node( const Prefix& prefix_ )
+    : prefix ( prefix_ )
+{
+    child[0] = NULL;
+    child[1] = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+BanTrie::BanTrie()
+    : _root ( NULL )
+    , _size ( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+BanTrie::~BanTrie()
+{
+    clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+BanTrie::bit( uint32 address, uint32 index )
+{
+    return (address >> (31 - index)) & 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+BanTrie::clear()
+{
+    destroy( _root );
+    _root = NULL;
+    _size = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+BanTrie::common( uint32 a, uint32 b, uint32 max )
+{
+    const uint32 diff = a ^ b;
+
+    uint32 length = 0;
+    while (length < max && !bit( diff, length ))
+        length++;
+
+    return length;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+BanTrie::covers( const vector<Prefix>& prefixes, uint32 address )
+{
+    const vector<Prefix>::const_iterator max = prefixes.end();
+    for ( vector<Prefix>::const_iterator it = prefixes.begin(); it != max; it++ ) {
+        if (!((it->address ^ address) & mask( it->length )))
+            return true;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+BanTrie::destroy( Node* node )
+{
+    if (!node)
+        return;
+
+    destroy( node->child[0] );
+    destroy( node->child[1] );
+    delete node;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+BanTrie::erase( const Prefix& prefix, User& user )
+{
+    erase( _root, prefix, user );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+BanTrie::erase( Node*& link, const Prefix& prefix, User& user )
+{
+    Node* const node = link;
+    if (!node)
+        return false;
+
+    const uint32 length = node->prefix.length;
+    if (length > prefix.length || ((node->prefix.address ^ prefix.address) & mask( length )))
+        return false;
+
+    bool found = false;
+    if (length == prefix.length) {
+        vector<User*>& users = node->users;
+        const vector<User*>::size_type max = users.size();
+        for ( vector<User*>::size_type i = 0; i < max; i++ ) {
+            if (users[i] != &user)
+                continue;
+
+            users[i] = users.back();
+            users.pop_back();
+            if (users.empty())
+                _size--;
+
+            found = true;
+            break;
+        }
+    }
+    else {
+        found = erase( node->child[ bit( prefix.address, length ) ], prefix, user );
+    }
+
+    // Nodes without users only stay as branches of two subtrees.
+    if (node->users.empty() && (!node->child[0] || !node->child[1])) {
+        link = node->child[0] ? node->child[0] : node->child[1];
+        delete node;
+    }
+
+    return found;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+BanTrie::insert( const Prefix& prefix, User& user )
+{
+    Node** link = &_root;
+    for ( ;; ) {
+        Node* const node = *link;
+
+        if (!node) {
+            Node* const leaf = new Node( prefix );
+            leaf->users.push_back( &user );
+            *link = leaf;
+            _size++;
+            return;
+        }
+
+        const uint32 length = node->prefix.length;
+        const uint32 c = common( node->prefix.address, prefix.address, length < prefix.length ? length : prefix.length );
+
+        if (c == length) {
+            if (c == prefix.length) {
+                if (node->users.empty())
+                    _size++;
+                node->users.push_back( &user );
+                return;
+            }
+
+            link = &node->child[ bit( prefix.address, c ) ];
+            continue;
+        }
+
+        // Prefix ends above node, or both diverge at c.
+        Node* const leaf = new Node( prefix );
+        leaf->users.push_back( &user );
+        _size++;
+
+        if (c == prefix.length) {
+            leaf->child[ bit( node->prefix.address, c ) ] = node;
+            *link = leaf;
+            return;
+        }
+
+        Prefix glue;
+        glue.address = prefix.address & mask( c );
+        glue.length  = c;
+
+        Node* const branch = new Node( glue );
+        branch->child[ bit( node->prefix.address, c ) ] = node;
+        branch->child[ bit( prefix.address, c ) ]      = leaf;
+        *link = branch;
+        return;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+BanTrie::mask( uint32 length )
+{
+    return length ? 0xffffffffU << (32 - length) : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int
+BanTrie::match( uint32 address, const vector<User*>* (&out)[MATCH_MAX] ) const
+{
+    int num = 0;
+    for ( const Node* node = _root; node; ) {
+        const uint32 length = node->prefix.length;
+        if ((node->prefix.address ^ address) & mask( length ))
+            break;
+
+        if (!node->users.empty())
+            out[num++] = &node->users;
+
+        if (length == 32)
+            break;
+
+        node = node->child[ bit( address, length ) ];
+    }
+
+    // most specific first
+    for ( int i = 0, j = num - 1; i < j; i++, j-- ) {
+        const vector<User*>* const tmp = out[i];
+        out[i] = out[j];
+        out[j] = tmp;
+    }
+
+    return num;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+BanTrie::parse( const string& s, vector<Prefix>& out )
+{
+    const char* p = s.c_str();
+    Prefix prefix;
+
+    // trailing wildcards: "*", "a.*", "a.b.*.*"
+    if (s.find( '*' ) != string::npos) {
+        uint32 address = 0;
+        uint32 octets = 0;
+
+        for ( ; *p != '*'; octets++ ) {
+            uint32 octet;
+            if (octets == 3 || parseOctet( p, octet ) || *p++ != '.')
+                return true;
+            address = (address << 8) | octet;
+        }
+
+        for ( uint32 wild = octets; ; ) {
+            if (*p++ != '*' || ++wild > 4)
+                return true;
+            if (!*p)
+                break;
+            if (*p++ != '.')
+                return true;
+        }
+
+        prefix.length  = octets * 8;
+        prefix.address = octets ? address << (32 - prefix.length) : 0;
+        out.push_back( prefix );
+        return false;
+    }
+
+    uint32 address;
+    if (parseQuad( p, address ))
+        return true;
+
+    // range: split into largest aligned blocks
+    if (*p == '-') {
+        p++;
+
+        uint32 last;
+        if (parseQuad( p, last ) || *p || last < address)
+            return true;
+
+        uint64 lo = address;
+        const uint64 hi = last;
+        while (lo <= hi) {
+            uint32 length = 32;
+            while (length > 0) {
+                const uint64 size = uint64( 1 ) << (33 - length);
+                if ((lo & (size - 1)) || lo + size - 1 > hi)
+                    break;
+                length--;
+            }
+
+            prefix.address = uint32( lo );
+            prefix.length  = length;
+            out.push_back( prefix );
+
+            lo += uint64( 1 ) << (32 - length);
+        }
+
+        return false;
+    }
+
+    prefix.length = 32;
+
+    // CIDR
+    if (*p == '/') {
+        p++;
+
+        uint32 length;
+        if (parseOctet( p, length ) || *p || length > 32)
+            return true;
+
+        prefix.length = length;
+    }
+    else if (*p) {
+        return true;
+    }
+
+    prefix.address = address & mask( prefix.length );
+    out.push_back( prefix );
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+BanTrie::parseAddress( const string& s, uint32& address )
+{
+    const char* p = s.c_str();
+    return parseQuad( p, address ) || *p;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t
+BanTrie::size() const
+{
+    return _size;
+}
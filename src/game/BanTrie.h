@@ -0,0 +1,94 @@
+#ifndef GAME_BANTRIE_H
+#define GAME_BANTRIE_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+class User;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * BanTrie is a path-compressed binary (Patricia) trie of IPv4 prefixes,
+ * each holding the banned users whose ip covers it. A lookup visits at
+ * most one node per address bit, so it costs O(32) however many bans
+ * exist.
+ *
+ * A ban address may be a single address, CIDR "a.b.c.d/n", trailing
+ * wildcards "a.b.*" or a range "a.b.c.d-e.f.g.h"; a range is split into
+ * the fewest prefixes covering it.
+ */
+class BanTrie
+{
+public:
+    struct Prefix {
+        uint32 address;  // host order, bits beyond length are zero
+        uint32 length;   // 0..32
+    };
+
+    enum { MATCH_MAX = 33 };  // one list per prefix length
+
+private:
+    struct Node {
+        Prefix        prefix;
+        Node*         child[2];
+        vector<User*> users;
+
+        Node( const Prefix& );
+    };
+
+    Node*  _root;
+    size_t _size;  // nodes holding users
+
+    void destroy ( Node* );
+    bool erase   ( Node*&, const Prefix&, User& );
+
+    static uint32 bit    ( uint32, uint32 );          // address, index from msb
+    static uint32 common ( uint32, uint32, uint32 );  // a, b, max length
+    static uint32 mask   ( uint32 );                  // length
+
+public:
+    BanTrie();
+    ~BanTrie();
+
+    void clear  ( );
+    void insert ( const Prefix&, User& );
+    void erase  ( const Prefix&, User& );
+
+    /**************************************************************************
+     * Find prefixes containing address.
+     *
+     * Fills out with the user lists of matching prefixes, most specific
+     * first, and returns the number of lists.
+     *
+     */
+    int match( uint32 address, const vector<User*>* (&out)[MATCH_MAX] ) const;
+
+    size_t size() const;
+
+    /**************************************************************************
+     * Returns true if any of prefixes contains address.
+     *
+     */
+    static bool covers( const vector<Prefix>& prefixes, uint32 address );
+
+    /**************************************************************************
+     * Parse dotted-quad address. Returns true on error.
+     *
+     */
+    static bool parseAddress( const string&, uint32& );
+
+    /**************************************************************************
+     * Parse ban address in any accepted form into prefixes. Returns true on
+     * error, in which case out is unchanged.
+     *
+     */
+    static bool parse( const string&, vector<Prefix>& out );
+
+private:
+    BanTrie( const BanTrie& );             // not copyable
+    BanTrie& operator=( const BanTrie& );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_BANTRIE_H
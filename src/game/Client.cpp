@@ -775,6 +775,7 @@ Client::xpBackup()
         user.xpSkills[i] = gclient.sess.skillpoints[i];
 
     user.timestamp = time( NULL );
+    userDB.journal( user );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -3,8 +3,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 Database::Database( const string& filename, const string& key )
-    : _filename ( filename )
-    , _key      ( key )
+    : _filename         ( filename )
+    , _key              ( key )
+    , _cursor           ( 0 )
+    , _end              ( 0 )
+    , _pendingKey       ( NULL )
+    , _pendingKeyLength ( 0 )
 {
 }
 
@@ -16,11 +20,24 @@ Database::~Database()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool
+Database::atEnd() const
+{
+    // a key ending the file still has its record to return
+    return _cursor >= _end && !_pendingKey;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 Database::close()
 {
-    _stream.close();
-    _stream.clear();
+    // release memory; clear() alone keeps capacity
+    vector<char>().swap( _buffer );
+    _cursor = 0;
+    _end = 0;
+    _pendingKey = NULL;
+    _pendingKeyLength = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -52,77 +69,130 @@ Database::logEnd( int num, const string& type )
 ///////////////////////////////////////////////////////////////////////////////
 
 bool
-Database::open( bool write, string& fname )
+Database::open( string& fname )
 {
-    _currentKeyValue.clear();
+    return openFile( _filename, fname, true );
+}
 
-    const ios::openmode mode = write ? ios::out : ios::in;
-    
-    // Get paths
-    char buffer[ MAX_CVAR_VALUE_STRING ];
-    trap_Cvar_VariableStringBuffer( "fs_homepath", buffer, sizeof( buffer ));
-    fname = buffer;
-    fname += "/";
+///////////////////////////////////////////////////////////////////////////////
 
-    trap_Cvar_VariableStringBuffer( "fs_game", buffer, sizeof( buffer ));
-    fname += buffer;
-    fname += "/";
-    fname += _filename;
+bool
+Database::openFile( const string& file, string& fname, bool warn )
+{
+    close();
 
-    // Open file
-    _stream.clear();
-    _stream.open( fname.c_str(), mode );
-    if ( !_stream.rdstate() )
-        return false;
+    fname = pathname( file );
 
-    // Error
-    ostringstream msg;
-    msg.str( "" );
-    msg << "-------" << endl
-        << "------- WARNING: unable to open " << fname << " ." << endl
-        << "------- Please verify file is available for access." << endl
-        << "-------" << endl;
-    trap_Printf( msg.str().c_str() );
+    FILE* const in = fopen( fname.c_str(), "rb" );
+    if (!in) {
+        if (!warn)
+            return true;
+
+        // Error
+        ostringstream msg;
+        msg.str( "" );
+        msg << "-------" << endl
+            << "------- WARNING: unable to open " << fname << " ." << endl
+            << "------- Please verify file is available for access." << endl
+            << "-------" << endl;
+        trap_Printf( msg.str().c_str() );
+
+        return true;
+    }
+
+    // Read whole file in large blocks; grows geometrically for large files.
+    const size_t block = 1 << 16;
+    for (;;) {
+        const size_t used = _buffer.size();
+        _buffer.resize( used + block );
 
-    return true;
+        const size_t num = fread( &_buffer[used], 1, block, in );
+        _buffer.resize( used + num );
+
+        if (num < block)
+            break;
+    }
+    fclose( in );
+
+    // Sentinel lets the last value be terminated in place.
+    _end = _buffer.size();
+    _buffer.push_back( '\0' );
+
+    return false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void
-Database::parseData( map<string,string>& data )
+Database::parseRecord( DatabaseRecord& rec )
 {
-    data.clear();
+    rec.clear();
 
-    string name;
-    string value;
+    const int keyField = rec.schema.find( _key.data(), _key.length() );
 
-    if ( _currentKeyValue.length() ) {
-        data[ _key ] = _currentKeyValue;
-        _currentKeyValue.clear();
+    if (_pendingKey) {
+        if (keyField != -1)
+            rec.set( keyField, _pendingKey, _pendingKeyLength );
+        _pendingKey = NULL;
     }
 
-    while ( !parsePair( name, value ) ) {
-        if ( name == _key ) {
-            _currentKeyValue = value;
+    const char* name;
+    const char* value;
+    size_t nameLength;
+    size_t valueLength;
+
+    while ( !parsePair( name, nameLength, value, valueLength )) {
+        const int field = rec.schema.find( name, nameLength );
+        if (field == -1)
+            continue;
+
+        if (field == keyField) {
+            _pendingKey = value;
+            _pendingKeyLength = valueLength;
             break;
         }
-        data[ name ] = value;
+
+        rec.set( field, value, valueLength );
     }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+string
+Database::pathname( const string& file )
+{
+    char buffer[ MAX_CVAR_VALUE_STRING ];
+    trap_Cvar_VariableStringBuffer( "fs_homepath", buffer, sizeof( buffer ));
+    string fname = buffer;
+    fname += "/";
+
+    trap_Cvar_VariableStringBuffer( "fs_game", buffer, sizeof( buffer ));
+    fname += buffer;
+    fname += "/";
+    fname += file;
+
+    return fname;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool
-Database::parsePair( string& name, string& value )
+Database::parsePair( const char*& name, size_t& nameLength, const char*& value, size_t& valueLength )
 {
     enum Mode { LTRIM, COMMENT, NAME, DELIM, VALUE };
     Mode mode = LTRIM;
     bool delimVisible = false;
 
-    int visibleLength = 0;
+    /* Names and values only ever shrink (NULs dropped, values trimmed), so
+     * they are compacted in place at out, which never passes _cursor.
+     */
+    char* const buffer = &_buffer[0];
+    char* out = NULL;
+    char* visibleEnd = NULL;
+
+    for ( ; _cursor < _end; _cursor++ ) {
+        const char c = buffer[_cursor];
 
-    for (char c; !_stream.get(c).rdstate(); ) {
         switch (mode) {
         case LTRIM:
             switch (c) {
@@ -139,7 +209,9 @@ Database::parsePair( string& name, string& value )
 
             default:
                 mode = NAME;
-                name = tolower( c );
+                out = buffer + _cursor;
+                name = out;
+                *out++ = tolower( c );
                 break;
             }
             break;
@@ -149,7 +221,6 @@ Database::parsePair( string& name, string& value )
             case '\n':  // NEWLINE
             case '\r':  // CARRIAGE-RETURN
                 mode = LTRIM;
-                name.clear();
                 break;
 
             default:
@@ -172,10 +243,11 @@ Database::parsePair( string& name, string& value )
             case '=':   // DELIMITER
                 mode = DELIM;
                 delimVisible = false;
+                nameLength = out - name;
                 break;
 
             default:
-                name += tolower( c );
+                *out++ = tolower( c );
                 break;
             }
             break;
@@ -185,7 +257,6 @@ Database::parsePair( string& name, string& value )
             case '\n':  // NEWLINE
             case '\r':  // CARRIAGE-RETURN
                 mode = LTRIM;
-                name.clear();
                 break;
 
             case '\0':  // NULL
@@ -196,16 +267,20 @@ Database::parsePair( string& name, string& value )
             case '=':  // DELIMITER
                 if (delimVisible) {
                     mode = VALUE;
-                    value = c;
-                    visibleLength = value.length();
+                    out = buffer + _cursor;
+                    value = out;
+                    *out++ = c;
+                    visibleEnd = out;
                 }
                 delimVisible = true;
                 break;
 
             default:
                 mode = VALUE;
-                value = c;
-                visibleLength = value.length();
+                out = buffer + _cursor;
+                value = out;
+                *out++ = c;
+                visibleEnd = out;
                 break;
             }
             break;
@@ -217,18 +292,19 @@ Database::parsePair( string& name, string& value )
 
             case '\n':  // NEWLINE
             case '\r':  // CARRIAGE-RETURN
-                if (visibleLength)
-                    value.resize( visibleLength );
+                _cursor++;
+                *visibleEnd = '\0';
+                valueLength = visibleEnd - value;
                 return false;
 
             case '\t':  // TAB
             case ' ':   // SPACE
-                value += ' ';
+                *out++ = ' ';
                 break;
 
             default:
-                value += c;
-                visibleLength = value.length();
+                *out++ = c;
+                visibleEnd = out;
                 break;
             }
             break;
@@ -241,8 +317,9 @@ Database::parsePair( string& name, string& value )
     if (mode != VALUE)
         return true;
 
-    if (visibleLength)
-        value.resize( visibleLength );
+    // visibleEnd is at most _end, where the sentinel is
+    *visibleEnd = '\0';
+    valueLength = visibleEnd - value;
 
     return false;
 }
@@ -19,6 +19,10 @@
  *     9. <NAME> is case-insensitive.
  *    10. Subsequent lines of NAME/VALUE pairs are part of the same record.
  *
+ * Files are read whole into memory in large blocks and tokenized in place;
+ * parsed records are slices of that buffer (see DatabaseRecord). Writing is
+ * done by DatabaseWriter.
+ *
  */
 class Database {
 public:
@@ -41,22 +45,50 @@ protected:
     void close();
 
     /**************************************************************************
-     * Open database file.
+     * Open and read database file.
+     *
+     * Param fname stores the full pathname.
+     *
+     * Returns true if error ocurred.
+     *
+     */
+    bool open( string& fname );
+
+    /**************************************************************************
+     * Open and read an arbitrary file in the database directory.
      *
-     * Param write true to open file for writing, otherwise for reading.
+     * Param file specifies filename (basename only).
+     * Param fname stores the full pathname.
+     * Param warn true to print a warning if file cannot be opened.
      *
      * Returns true if error ocurred.
      *
      */
-    bool open( bool write, string& );
+    bool openFile( const string& file, string& fname, bool warn );
+
+    /**************************************************************************
+     * Returns true when all records have been parsed.
+     *
+     */
+    bool atEnd() const;
+
+    /**************************************************************************
+     * Get full pathname of a file in the database directory.
+     *
+     * Param file specifies filename (basename only).
+     *
+     */
+    string pathname( const string& file );
 
     /**************************************************************************
-     * Parse a record-data from open intput stream.
+     * Parse a record from open file.
      *
-     * Param data is populated with NAME/VALUE pairs if any.
+     * Param rec is populated with values of fields in its schema; other
+     * names are ignored. The first record holds any pairs preceding the
+     * first key.
      *
      */
-    void parseData( map<string,string>& data );
+    void parseRecord( DatabaseRecord& rec );
 
     /*************************************************************************/
 
@@ -67,23 +99,26 @@ protected:
 
     const string  _filename; // filename (basename only) used for database
     const string  _key;      // name of key for record boundries
-    fstream       _stream;   // IO object
 
 private:
     /**************************************************************************
-     * Parse a name/value pair from open input stream.
-     *
-     * Param name stores the parsed name.
-     * Param value stores the parsed value.
+     * Parse a name/value pair from buffer. Name is lowercased and value is
+     * NUL-terminated in place.
      *
      * Returns true if no name/value pair was parsed.
      *
      */
-    bool parsePair( string& name, string& value );
+    bool parsePair( const char*& name, size_t& nameLength, const char*& value, size_t& valueLength );
 
     /*************************************************************************/
 
-    string _currentKeyValue;
+    vector<char> _buffer;     // file contents plus NUL sentinel
+    size_t       _cursor;     // parse position in _buffer
+    size_t       _end;        // file length
+
+    const char*  _pendingKey;        // key value which ended previous record
+    size_t       _pendingKeyLength;
+
     Process::mstime_t _logbeginTimestamp;
 };
 
@@ -0,0 +1,160 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+DatabaseSchema::DatabaseSchema( const char* const* names )
+{
+    for ( ; *names; names++ ) {
+        _names.push_back( *names );
+        _lengths.push_back( strlen( *names ));
+    }
+
+    // Keep table sparse so probes are short.
+    uint32 tsize = 16;
+    while (tsize < _names.size() * 4)
+        tsize <<= 1;
+
+    _mask = tsize - 1;
+    _table.assign( tsize, -1 );
+
+    const int max = int( _names.size() );
+    for ( int i = 0; i < max; i++ ) {
+        uint32 slot = hash( _names[i], _lengths[i] ) & _mask;
+        while (_table[slot] != -1)
+            slot = (slot + 1) & _mask;
+        _table[slot] = i;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DatabaseSchema::~DatabaseSchema()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int
+DatabaseSchema::find( const char* name, size_t length ) const
+{
+    for ( uint32 slot = hash( name, length ) & _mask; _table[slot] != -1; slot = (slot + 1) & _mask ) {
+        const int i = _table[slot];
+        if (_lengths[i] == length && !memcmp( _names[i], name, length ))
+            return i;
+    }
+
+    return -1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+DatabaseSchema::hash( const char* s, size_t length )
+{
+    // FNV-1a
+    uint32 h = 2166136261U;
+    for ( const char* const max = s + length; s < max; s++ ) {
+        h ^= uint8( *s );
+        h *= 16777619U;
+    }
+    return h;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t
+DatabaseSchema::size() const
+{
+    return _names.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DatabaseRecord::DatabaseRecord( const DatabaseSchema& schema_ )
+    : schema ( schema_ )
+{
+    _values.resize( schema.size() );
+    clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DatabaseRecord::~DatabaseRecord()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseRecord::clear()
+{
+    const vector<Value>::iterator max = _values.end();
+    for ( vector<Value>::iterator it = _values.begin(); it != max; it++ ) {
+        it->data   = NULL;
+        it->length = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char*
+DatabaseRecord::get( int field ) const
+{
+    const char* const data = _values[field].data;
+    return data ? data : "";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+DatabaseRecord::has( int field ) const
+{
+    return _values[field].data != NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t
+DatabaseRecord::length( int field ) const
+{
+    return _values[field].length;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseRecord::set( int field, const char* data, size_t length )
+{
+    Value& v = _values[field];
+    v.data   = data;
+    v.length = length;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+string
+DatabaseRecord::str( int field ) const
+{
+    const Value& v = _values[field];
+    return v.data ? string( v.data, v.length ) : string();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int64
+DatabaseRecord::toInt( int field ) const
+{
+    const char* p = get( field );
+    while (*p == ' ')
+        p++;
+
+    bool negative = false;
+    if (*p == '-' || *p == '+')
+        negative = *p++ == '-';
+
+    int64 n = 0;
+    for ( ; *p >= '0' && *p <= '9'; p++ )
+        n = n * 10 + (*p - '0');
+
+    return negative ? -n : n;
+}
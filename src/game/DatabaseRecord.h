@@ -0,0 +1,86 @@
+#ifndef GAME_DATABASERECORD_H
+#define GAME_DATABASERECORD_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * DatabaseSchema maps the lowercase field names a record type understands
+ * to field numbers. Lookup is by a hash table built once at construction,
+ * so parsing never compares a name against more than one candidate in the
+ * usual case.
+ */
+class DatabaseSchema
+{
+private:
+    vector<const char*> _names;
+    vector<size_t>      _lengths;
+    vector<int>         _table;  // open-addressed field numbers, -1 if empty
+    uint32              _mask;
+
+    static uint32 hash( const char*, size_t );
+
+public:
+    /**************************************************************************
+     * Constructor.
+     *
+     * Param names is a NULL-terminated list of lowercase field names; the
+     * position in the list is the field number.
+     *
+     */
+    DatabaseSchema( const char* const* names );
+    ~DatabaseSchema();
+
+    /**************************************************************************
+     * Returns field number of name, or -1 if not in schema.
+     *
+     */
+    int find( const char* name, size_t length ) const;
+
+    size_t size() const;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * DatabaseRecord holds the fields of one record parsed by Database. Values
+ * point into the parse buffer and remain valid until the next record is
+ * parsed or the database is closed; copy what must be kept.
+ */
+class DatabaseRecord
+{
+private:
+    struct Value {
+        const char* data;    // NUL-terminated, NULL when absent
+        size_t      length;
+    };
+
+    vector<Value> _values;
+
+public:
+    DatabaseRecord( const DatabaseSchema& );
+    ~DatabaseRecord();
+
+    void clear ( );
+    void set   ( int, const char*, size_t );  // field, NUL-terminated value, length
+
+    bool        has    ( int ) const;
+    const char* get    ( int ) const;  // "" when absent
+    size_t      length ( int ) const;
+    string      str    ( int ) const;
+
+    /**************************************************************************
+     * Parse leading integer of field, as for istream extraction: leading
+     * spaces are skipped and parsing stops at the first non-digit, so
+     * trailing comments are ignored.
+     *
+     * Returns 0 if absent or not a number.
+     *
+     */
+    int64 toInt( int ) const;
+
+    const DatabaseSchema& schema;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_DATABASERECORD_H
@@ -0,0 +1,194 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+DatabaseWriter::Job::Job( const string& filename_, const string& type_ )
+    : filename ( filename_ )
+    , type     ( type_ )
+    , capture  ( 0 )
+    , _write   ( 0 )
+    , _num     ( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DatabaseWriter::Job::~Job()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::Job::finish( bool )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DatabaseWriter::DatabaseWriter()
+    : _platform ( 0 )
+    , _stop     ( false )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DatabaseWriter::~DatabaseWriter()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::execute( Job& job )
+{
+    const Process::ustime_t begin = process.ustime();
+
+    ostringstream out;
+    job._num = job.write( out );
+    const string data = out.str();
+
+    // Write beside the database and rename over it, so readers and crashes
+    // only ever see a complete file.
+    const string tmpname = job.filename + ".tmp";
+    FILE* file = fopen( tmpname.c_str(), "wb" );
+    if (!file) {
+        job._error = "unable to open " + tmpname;
+    }
+    else {
+        bool error = fwrite( data.data(), 1, data.length(), file ) != data.length();
+        error = process.fileSync( file ) || error;
+        error = fclose( file ) || error;
+
+        if (error) {
+            job._error = "error writing " + tmpname;
+            remove( tmpname.c_str() );
+        }
+        else if (process.fileReplace( tmpname, job.filename )) {
+            job._error = "unable to rename " + tmpname;
+            remove( tmpname.c_str() );
+        }
+    }
+
+    job._write = process.ustime() - begin;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::report( Job& job )
+{
+    ostringstream msg;
+    if (job._error.empty()) {
+        msg << "Writing: " << job.filename << ", " << job._num << " " << job.type
+            << " (capture " << job.capture / 1000 << "ms, write " << job._write / 1000 << "ms)" << endl;
+    }
+    else {
+        msg << "-------" << endl
+            << "------- WARNING: " << job._error << " ." << endl
+            << "------- " << job.filename << " was not updated." << endl
+            << "-------" << endl;
+    }
+    trap_Printf( msg.str().c_str() );
+
+    job.finish( !job._error.empty() );
+    delete &job;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::run()
+{
+    if (!_platform)
+        return;
+
+    list<Job*> done;
+
+    platformLock();
+    done.swap( _done );
+    platformUnlock();
+
+    const list<Job*>::iterator end = done.end();
+    for ( list<Job*>::iterator it = done.begin(); it != end; it++ )
+        report( **it );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::shutdown()
+{
+    if (!_platform)
+        return;
+
+    // Writer drains the queue before it honors stop.
+    platformLock();
+    _stop = true;
+    platformUnlock();
+
+    platformWake();
+    platformJoin();
+    _stop = false;
+
+    const list<Job*>::iterator end = _done.end();
+    for ( list<Job*>::iterator it = _done.begin(); it != end; it++ )
+        report( **it );
+    _done.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::submit( Job* job )
+{
+    if (!_platform && !platformSpawn()) {
+        G_Printf( "WARNING: database writer: unable to start thread\n" );
+        execute( *job );
+        report( *job );
+        return;
+    }
+
+    platformLock();
+    _queue.push_back( job );
+    platformUnlock();
+
+    platformWake();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::writerMain( DatabaseWriter& writer )
+{
+    for (;;) {
+        writer.platformWaitWake();
+
+        for (;;) {
+            writer.platformLock();
+            if (writer._queue.empty()) {
+                const bool stop = writer._stop;
+                writer.platformUnlock();
+
+                if (stop)
+                    return;
+                break;
+            }
+
+            Job* const job = writer._queue.front();
+            writer._queue.pop_front();
+            writer.platformUnlock();
+
+            writer.execute( *job );
+
+            writer.platformLock();
+            writer._done.push_back( job );
+            writer.platformUnlock();
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DatabaseWriter dbWriter;
@@ -0,0 +1,89 @@
+#ifndef GAME_DATABASEWRITER_H
+#define GAME_DATABASEWRITER_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Background thread which writes database snapshots to disk.
+ *
+ * A database captures a copy of its records into a Job on the main thread
+ * and submits it. The writer thread serializes the job into a temporary
+ * file, syncs it and renames it over the database file. Completed jobs are
+ * reported and finished on the main thread by run() on the next frame.
+ */
+class DatabaseWriter
+{
+public:
+    class Job {
+        friend class DatabaseWriter;
+
+    public:
+        Job( const string&, const string& );
+        virtual ~Job();
+
+        /**********************************************************************
+         * Serialize captured records. Called on the writer thread; must not
+         * touch game state or call trap_* syscalls.
+         *
+         * Returns number of records written.
+         *
+         */
+        virtual int write( ostream& ) = 0;
+
+        /**********************************************************************
+         * Called on the main thread after the file is in place or on error.
+         *
+         * Param error true if file was not written.
+         *
+         */
+        virtual void finish( bool error );
+
+        const string      filename;  // full pathname of database file
+        const string      type;      // record type for log, eg: "users"
+        Process::ustime_t capture;   // usec spent capturing copy, set by submitter
+
+    private:
+        Process::ustime_t _write;  // usec spent writing
+        int               _num;    // records written
+        string            _error;  // empty on success
+    };
+
+private:
+    struct Platform;  // thread, lock and semaphore; see <platform>/DatabaseWriter.cpp
+
+    Platform* _platform;
+    bool      _stop;   // writer exits when woken with this set
+
+    // Guarded by platformLock().
+    list<Job*> _queue;  // submitted, not yet written
+    list<Job*> _done;   // written, not yet reported
+
+    void execute ( Job& );  // write job to disk, either thread
+    void report  ( Job& );  // print result and finish job, main thread
+
+    // Platform-specific.
+    bool platformSpawn    ( );  // allocate and start writer thread
+    void platformJoin     ( );  // wait for writer thread to exit and free
+    void platformLock     ( );
+    void platformUnlock   ( );
+    void platformWake     ( );  // signal writer that a job (or stop) is ready
+    void platformWaitWake ( );  // writer side of platformWake()
+
+public:
+    DatabaseWriter();
+    ~DatabaseWriter();
+
+    void submit   ( Job* );  // queue job for writer thread, takes ownership
+    void run      ( );       // report jobs completed since last call
+    void shutdown ( );       // wait for all jobs, report them and stop thread
+
+    static void writerMain( DatabaseWriter& );  // thread body
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+extern DatabaseWriter dbWriter;
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_DATABASEWRITER_H
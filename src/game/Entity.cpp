@@ -9,7 +9,17 @@ namespace {
 ///////////////////////////////////////////////////////////////////////////////
 
 Entity::Entity( )
-    : slot ( __nextSlot++ )
+    : _indexNext  ( NULL )
+    , _indexPrev  ( NULL )
+    , _indexKind  ( 0 )
+    , _indexTeam  ( TEAM_NUM_TEAMS )
+    , _schedNext  ( NULL )
+    , _schedPrev  ( NULL )
+    , _schedTime  ( 0 )
+    , _schedState ( 0 )
+    , _schedLevel ( 0 )
+    , _schedIndex ( 0 )
+    , slot        ( __nextSlot++ )
 {
 
 }
@@ -25,7 +35,17 @@ Entity::~Entity( )
 
 void Entity::init( )
 {
-
+    _indexNext  = NULL;
+    _indexPrev  = NULL;
+    _indexKind  = 0;
+    _indexTeam  = TEAM_NUM_TEAMS;
+
+    _schedNext  = NULL;
+    _schedPrev  = NULL;
+    _schedTime  = 0;
+    _schedState = 0;
+    _schedLevel = 0;
+    _schedIndex = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,22 @@
 
 class Entity
 {
+    friend class EntityIndex;
+    friend class EntityScheduler;
+
+private:
+    Entity* _indexNext;   // intrusive links within an EntityIndex list
+    Entity* _indexPrev;
+    uint8   _indexKind;
+    uint8   _indexTeam;   // team counted for as an armed landmine
+
+    Entity* _schedNext;   // intrusive links within a wheel bucket
+    Entity* _schedPrev;
+    int     _schedTime;   // nextthink when parked in the wheel
+    uint8   _schedState;
+    uint8   _schedLevel;  // wheel bucket holding entity
+    uint8   _schedIndex;
+
 public:
     Entity        ( );
     ~Entity       ( );
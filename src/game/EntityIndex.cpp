@@ -0,0 +1,205 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+EntityIndex::EntityIndex()
+{
+    init();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+EntityIndex::~EntityIndex()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+gentity_t*
+EntityIndex::after( Kind kind, const gentity_t* ent ) const
+{
+    if (!ent)
+        return first( kind );
+
+    const Entity& e = g_entityObjects[ent - g_entities];
+    if (e._indexKind == kind)
+        return e._indexNext ? &g_entities[e._indexNext->slot] : NULL;
+
+    // no longer filed here: resume at the first member past its slot
+    for ( const Entity* p = _head[kind]; p; p = p->_indexNext ) {
+        if (p->slot > e.slot)
+            return &g_entities[p->slot];
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+gentity_t*
+EntityIndex::first( Kind kind ) const
+{
+    return _head[kind] ? &g_entities[_head[kind]->slot] : NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityIndex::init()
+{
+    memset( _head, 0, sizeof(_head) );
+    memset( _tail, 0, sizeof(_tail) );
+    memset( _landmines, 0, sizeof(_landmines) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+EntityIndex::Kind
+EntityIndex::kindOf( const gentity_t& ent )
+{
+    if (!ent.inuse)
+        return KIND_NONE;
+
+    switch (ent.s.eType) {
+        case ET_MISSILE:       return KIND_MISSILE;
+        case ET_CONSTRUCTIBLE: return KIND_CONSTRUCTIBLE;
+        case ET_ITEM:          return KIND_ITEM;
+        case ET_CORPSE:        return KIND_CORPSE;
+
+        default:
+            return KIND_NONE;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint8
+EntityIndex::landmineTeamOf( const gentity_t& ent )
+{
+    if (kindOf( ent ) != KIND_MISSILE)
+        return TEAM_NUM_TEAMS;
+
+    switch (ent.methodOfDeath) {
+        case MOD_LANDMINE:
+            break;
+
+        case MOD_POISON_GAS:
+            if (ent.poisonGasWeaponType != WP_LANDMINE_PGAS)
+                return TEAM_NUM_TEAMS;
+            break;
+
+        default:
+            return TEAM_NUM_TEAMS;
+    }
+
+    // unarmed mines are team+4, triggered ones team+8
+    if (ent.s.teamNum < 0 || ent.s.teamNum >= 4)
+        return TEAM_NUM_TEAMS;
+
+    return uint8( ent.s.teamNum );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+EntityIndex::landmines( team_t team ) const
+{
+    if (team < 0 || team >= TEAM_NUM_TEAMS)
+        return 0;
+
+    return _landmines[team];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityIndex::link( Entity& e, Kind kind )
+{
+    // Insert in slot order, searching from the tail since fresh
+    // entities tend to take high slots.
+    Entity* prev = _tail[kind];
+    while (prev && prev->slot > e.slot)
+        prev = prev->_indexPrev;
+
+    e._indexPrev = prev;
+    e._indexNext = prev ? prev->_indexNext : _head[kind];
+
+    if (e._indexNext)
+        e._indexNext->_indexPrev = &e;
+    else
+        _tail[kind] = &e;
+
+    if (prev)
+        prev->_indexNext = &e;
+    else
+        _head[kind] = &e;
+
+    e._indexKind = uint8( kind );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityIndex::remove( gentity_t* ent )
+{
+    Entity& e = g_entityObjects[ent - g_entities];
+
+    if (e._indexKind != KIND_NONE)
+        unlink( e );
+
+    if (e._indexTeam != TEAM_NUM_TEAMS) {
+        _landmines[e._indexTeam]--;
+        e._indexTeam = TEAM_NUM_TEAMS;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityIndex::unlink( Entity& e )
+{
+    const Kind kind = Kind( e._indexKind );
+
+    if (e._indexPrev)
+        e._indexPrev->_indexNext = e._indexNext;
+    else
+        _head[kind] = e._indexNext;
+
+    if (e._indexNext)
+        e._indexNext->_indexPrev = e._indexPrev;
+    else
+        _tail[kind] = e._indexPrev;
+
+    e._indexNext = NULL;
+    e._indexPrev = NULL;
+    e._indexKind = KIND_NONE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityIndex::update( gentity_t* ent )
+{
+    Entity& e = g_entityObjects[ent - g_entities];
+
+    const Kind kind = kindOf( *ent );
+    if (kind != e._indexKind) {
+        if (e._indexKind != KIND_NONE)
+            unlink( e );
+        if (kind != KIND_NONE)
+            link( e, kind );
+    }
+
+    const uint8 team = landmineTeamOf( *ent );
+    if (team != e._indexTeam) {
+        if (e._indexTeam != TEAM_NUM_TEAMS)
+            _landmines[e._indexTeam]--;
+        if (team != TEAM_NUM_TEAMS)
+            _landmines[team]++;
+        e._indexTeam = team;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+EntityIndex entityIndex;
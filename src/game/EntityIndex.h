@@ -0,0 +1,64 @@
+#ifndef GAME_ENTITYINDEX_H
+#define GAME_ENTITYINDEX_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * EntityIndex keeps in-use entities of a few eTypes on intrusive lists, in
+ * slot order, so code looking for eg: missiles walks only those instead of
+ * every slot up to level.num_entities. It also counts armed landmines per
+ * team, as G_CountTeamLandmines used to by scanning.
+ *
+ * An entity is filed by update(), which is called where an indexed eType is
+ * assigned, where a landmine is armed or triggered, and for every entity
+ * G_RunFrame runs, so a list never misses a member but may briefly hold one
+ * whose eType has since changed. Scans keep their eType tests for that.
+ *
+ * after() resumes from any entity, even one freed or refiled meanwhile, so
+ * loops may free entities as they go.
+ */
+class EntityIndex
+{
+public:
+    enum Kind {
+        KIND_NONE,
+        KIND_MISSILE,
+        KIND_CONSTRUCTIBLE,
+        KIND_ITEM,
+        KIND_CORPSE,
+        NUM_KINDS
+    };
+
+private:
+    Entity* _head[NUM_KINDS];
+    Entity* _tail[NUM_KINDS];
+    uint32  _landmines[TEAM_NUM_TEAMS];  // armed, by team
+
+    EntityIndex( const EntityIndex& );             // not copyable
+    EntityIndex& operator=( const EntityIndex& );
+
+    void link   ( Entity&, Kind );
+    void unlink ( Entity& );
+
+    static Kind  kindOf         ( const gentity_t& );
+    static uint8 landmineTeamOf ( const gentity_t& );  // TEAM_NUM_TEAMS if not an armed landmine
+
+public:
+    EntityIndex();
+    ~EntityIndex();
+
+    gentity_t* after     ( Kind, const gentity_t* ) const;  // next by slot, or first if NULL
+    gentity_t* first     ( Kind ) const;
+    void       init      ( );
+    uint32     landmines ( team_t ) const;
+    void       remove    ( gentity_t* );  // entity is about to be cleared
+    void       update    ( gentity_t* );  // refile after eType or landmine state change
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+extern EntityIndex entityIndex;
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_ENTITYINDEX_H
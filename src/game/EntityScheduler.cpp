@@ -0,0 +1,401 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+EntityScheduler::EntityScheduler()
+{
+    init( 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+EntityScheduler::~EntityScheduler()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::advance( int time )
+{
+    if (level.match_pause != PAUSE_NONE) {
+        wakeAll();
+        _next = time + 1;
+        return;
+    }
+
+    // Nothing to expire, or the clock jumped too far to step through.
+    if (!_numTimed || time - _next >= WHEEL_SPAN) {
+        if (_numTimed)
+            wakeAll();
+        _next = time + 1;
+        return;
+    }
+
+    while (_next <= time)
+        tick();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+EntityScheduler::awake() const
+{
+    uint32 count = 0;
+    for ( int i = next( 0 ); i >= 0; i = next( i + 1 )) {
+        if (g_entities[i].inuse)
+            count++;
+    }
+
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+EntityScheduler::canSleep( const gentity_t& ent ) const
+{
+    if (ent.s.number < MAX_CLIENTS || !ent.inuse)
+        return false;
+
+    // only judge an entity on the state G_RunEntity just left it in
+    if (ent.runframe != level.framenum)
+        return false;
+
+    if (level.match_pause != PAUSE_NONE)
+        return false;
+
+    // events are cleared, and temporaries freed, by G_RunEntity
+    if (ent.s.event || ent.freeAfterEvent || ent.unlinkAfterEvent)
+        return false;
+
+    if (ent.tagParent || ent.s.eFlags & EF_PATH_LINK)
+        return false;
+
+    if (ent.physicsObject)
+        return false;
+
+    // moved last frame, so instantVelocity is due to change
+    if (!VectorCompare( ent.instantVelocity, vec3_origin ))
+        return false;
+
+    if (ent.scriptEvents) {
+        if (ent.scriptStatus.scriptEventIndex >= 0)
+            return false;
+
+        if (ent.scriptStatus.scriptFlags & (SCFL_GOING_TO_MARKER | SCFL_ANIMATING))
+            return false;
+    }
+
+    switch (ent.s.eType) {
+        case ET_MISSILE:
+        case ET_FLAMEBARREL:
+        case ET_FP_PARTS:
+        case ET_FIRE_COLUMN:
+        case ET_FIRE_COLUMN_SMOKE:
+        case ET_EXPLO_PART:
+        case ET_RAMJET:
+        case ET_FLAMETHROWER_CHUNK:
+        case ET_ITEM:
+        case ET_PROP:
+        case ET_PORTAL:
+            return false;
+
+        case ET_HEALER:
+        case ET_SUPPLIER:
+            // mirror health into target_ent every frame
+            if (ent.target_ent)
+                return false;
+            break;
+
+        case ET_MOVER:
+            // Team slaves are moved by their captain and never think, but
+            // these two classes unlink themselves whenever they get linked.
+            if (ent.flags & FL_TEAMSLAVE)
+                return Q_stricmp( ent.classname, "func_tramcar" ) && Q_stricmp( ent.classname, "func_rotating" );
+
+            if (ent.s.pos.trType != TR_STATIONARY || ent.s.apos.trType != TR_STATIONARY)
+                return false;
+            break;
+
+        default:
+            break;
+    }
+
+    // overdue but held back (eg: invisible or unlinked); keep polling
+    return ent.nextthink <= 0 || ent.nextthink > level.time;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::cascade( int wlevel, int index )
+{
+    Entity* e = _wheel[wlevel][index];
+    _wheel[wlevel][index] = NULL;
+
+    while (e) {
+        Entity* const enext = e->_schedNext;
+        insert( *e );
+        e = enext;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+EntityScheduler::dormant() const
+{
+    return _numDormant;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::free( gentity_t* ent )
+{
+    const int slot = ent->s.number;
+    if (slot < MAX_CLIENTS)
+        return;
+
+    Entity& e = g_entityObjects[slot];
+    rouse( e );
+
+    _awake[slot >> 5] &= ~(1U << (slot & 31));
+    e._schedState = STATE_FREE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::init( int time )
+{
+    memset( _awake, 0, sizeof(_awake) );
+    memset( _wheel, 0, sizeof(_wheel) );
+
+    _next       = time + 1;
+    _numTimed   = 0;
+    _numDormant = 0;
+
+    // clients always run
+    for ( int i = 0; i < MAX_CLIENTS; i++ )
+        _awake[i >> 5] |= 1U << (i & 31);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::insert( Entity& e )
+{
+    // Pick the finest level whose span covers the delay; beyond the top
+    // level, park in the farthest bucket and re-sort when it cascades.
+    int when = e._schedTime;
+    const int delay = when - _next;
+
+    int wlevel = 0;
+    while (wlevel < WHEEL_LEVELS - 1 && delay >= 1 << (WHEEL_BITS * (wlevel + 1)))
+        wlevel++;
+
+    if (delay >= WHEEL_SPAN)
+        when = _next + WHEEL_SPAN - 1;
+
+    const int index = (when >> (WHEEL_BITS * wlevel)) & WHEEL_MASK;
+
+    Entity*& head = _wheel[wlevel][index];
+    e._schedPrev  = NULL;
+    e._schedNext  = head;
+    e._schedLevel = uint8( wlevel );
+    e._schedIndex = uint8( index );
+    if (head)
+        head->_schedPrev = &e;
+    head = &e;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int
+EntityScheduler::next( int slot ) const
+{
+    const int limit = level.num_entities;
+
+    while (slot < limit) {
+        uint32 word = _awake[slot >> 5] >> (slot & 31);
+        if (!word) {
+            slot = (slot | 31) + 1;
+            continue;
+        }
+
+        while (!(word & 1)) {
+            word >>= 1;
+            slot++;
+        }
+
+        return slot < limit ? slot : -1;
+    }
+
+    return -1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::remove( Entity& e )
+{
+    if (e._schedPrev)
+        e._schedPrev->_schedNext = e._schedNext;
+    else
+        _wheel[e._schedLevel][e._schedIndex] = e._schedNext;
+
+    if (e._schedNext)
+        e._schedNext->_schedPrev = e._schedPrev;
+
+    e._schedNext = NULL;
+    e._schedPrev = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::rouse( Entity& e )
+{
+    switch (e._schedState) {
+        case STATE_AWAKE:
+            return;
+
+        case STATE_TIMED:
+            remove( e );
+            _numTimed--;
+            break;
+
+        case STATE_DORMANT:
+            _numDormant--;
+            break;
+
+        default:
+            break;
+    }
+
+    _awake[e.slot >> 5] |= 1U << (e.slot & 31);
+    e._schedState = STATE_AWAKE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::settle( gentity_t* ent )
+{
+    Entity& e = g_entityObjects[ent->s.number];
+    if (e._schedState != STATE_AWAKE || !canSleep( *ent ))
+        return;
+
+    _awake[e.slot >> 5] &= ~(1U << (e.slot & 31));
+
+    if (ent->nextthink > level.time) {
+        e._schedTime  = ent->nextthink;
+        e._schedState = STATE_TIMED;
+        insert( e );
+        _numTimed++;
+    }
+    else {
+        e._schedState = STATE_DORMANT;
+        _numDormant++;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::spawn( gentity_t* ent )
+{
+    rouse( g_entityObjects[ent->s.number] );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::thinkChanged( const ThinkTime& time )
+{
+    // recover the slot from the field's address
+    const char* const base = reinterpret_cast<const char*>( &g_entities[0].nextthink );
+    const char* const addr = reinterpret_cast<const char*>( &time );
+
+    if (addr < base || addr >= base + MAX_GENTITIES * sizeof(gentity_t))
+        return;
+
+    wake( &g_entities[ (addr - base) / sizeof(gentity_t) ] );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::tick()
+{
+    const int time  = _next;
+    const int index = time & WHEEL_MASK;
+
+    // Level 0 wrapped: pull the next bucket of each coarser level down,
+    // stopping at the first level that did not wrap as well.
+    if (!index) {
+        for ( int wlevel = 1; wlevel < WHEEL_LEVELS; wlevel++ ) {
+            const int i = (time >> (WHEEL_BITS * wlevel)) & WHEEL_MASK;
+            cascade( wlevel, i );
+            if (i)
+                break;
+        }
+    }
+
+    Entity* e = _wheel[0][index];
+    _wheel[0][index] = NULL;
+
+    while (e) {
+        Entity* const enext = e->_schedNext;
+
+        e->_schedNext  = NULL;
+        e->_schedPrev  = NULL;
+        e->_schedState = STATE_AWAKE;
+        _awake[e->slot >> 5] |= 1U << (e->slot & 31);
+        _numTimed--;
+
+        e = enext;
+    }
+
+    _next = time + 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+EntityScheduler::timed() const
+{
+    return _numTimed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::wake( gentity_t* ent )
+{
+    if (ent->s.number < MAX_CLIENTS || !ent->inuse)
+        return;
+
+    rouse( g_entityObjects[ent->s.number] );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+EntityScheduler::wakeAll()
+{
+    if (!_numTimed && !_numDormant)
+        return;
+
+    for ( int i = MAX_CLIENTS; i < MAX_GENTITIES; i++ ) {
+        Entity& e = g_entityObjects[i];
+        if (e._schedState == STATE_TIMED || e._schedState == STATE_DORMANT)
+            rouse( e );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+EntityScheduler entityScheduler;
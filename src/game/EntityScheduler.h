@@ -0,0 +1,88 @@
+#ifndef GAME_ENTITYSCHEDULER_H
+#define GAME_ENTITYSCHEDULER_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * EntityScheduler decides which entities G_RunFrame runs.
+ *
+ * An entity is awake from spawn until a frame leaves it idle, meaning the
+ * next G_RunEntity would do nothing but test nextthink (see canSleep). It
+ * is then parked in a hierarchical timer wheel keyed on nextthink, or left
+ * dormant if it has none, and costs nothing per frame until the wheel
+ * reaches that time or something wakes it: a write to nextthink, an event,
+ * a script, a use/touch/pain/die callback, or a change of origin, entstate
+ * or mover state.
+ *
+ * Awake slots are kept in a bitmap walked in slot order, so G_RunFrame
+ * visits them in the same order as the old loop over every slot and
+ * tagParent-first recursion is unchanged. Running a sleeping entity through
+ * that recursion is harmless. Client slots are always awake, and nothing
+ * sleeps while the match is paused because pausing shifts every nextthink.
+ *
+ * The wheel has WHEEL_LEVELS levels of WHEEL_SIZE buckets; level 0 buckets
+ * are one millisecond wide and each level is WHEEL_SIZE times coarser than
+ * the one below. Buckets are cascaded down as the clock reaches them.
+ */
+class EntityScheduler
+{
+public:
+    enum {
+        WHEEL_BITS   = 6,
+        WHEEL_SIZE   = 1 << WHEEL_BITS,                 // buckets per level
+        WHEEL_MASK   = WHEEL_SIZE - 1,
+        WHEEL_LEVELS = 4,
+        WHEEL_SPAN   = 1 << (WHEEL_BITS * WHEEL_LEVELS),  // msec; ~4.6 hours
+    };
+
+private:
+    enum State {
+        STATE_FREE,
+        STATE_AWAKE,
+        STATE_TIMED,    // in wheel until nextthink
+        STATE_DORMANT,  // no nextthink; waits to be woken
+    };
+
+    uint32  _awake[ MAX_GENTITIES / 32 ];       // bit per slot
+    Entity* _wheel[ WHEEL_LEVELS ][ WHEEL_SIZE ];
+    int     _next;                              // next msec tick to process
+    uint32  _numTimed;
+    uint32  _numDormant;
+
+    EntityScheduler( const EntityScheduler& );             // not copyable
+    EntityScheduler& operator=( const EntityScheduler& );
+
+    bool canSleep ( const gentity_t& ) const;
+    void cascade  ( int, int );        // level, bucket
+    void insert   ( Entity& );
+    void remove   ( Entity& );
+    void rouse    ( Entity& );         // make awake, from any state
+    void tick     ( );
+
+public:
+    EntityScheduler();
+    ~EntityScheduler();
+
+    void advance ( int );          // wake entities due by level time
+    void free    ( gentity_t* );   // entity is about to be cleared
+    void init    ( int );          // level time
+    int  next    ( int ) const;    // first awake slot at or after slot, or -1
+    void settle  ( gentity_t* );   // after running entity, park it if idle
+    void spawn   ( gentity_t* );
+    void wake    ( gentity_t* );
+    void wakeAll ( );
+
+    void thinkChanged ( const ThinkTime& );
+
+    uint32 awake   ( ) const;  // awake slots in use
+    uint32 dormant ( ) const;
+    uint32 timed   ( ) const;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+extern EntityScheduler entityScheduler;
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_ENTITYSCHEDULER_H
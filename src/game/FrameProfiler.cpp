@@ -0,0 +1,173 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char* const STAGE_NAMES[] = {
+    "frame",
+    "housekeeping",
+    "cvars",
+    "molotov",
+    "entities",
+    "ghost prune",
+    "clients",
+    "hitmode deferred",
+    "wolfmp",
+    "exit rules",
+    "team status",
+    "vote",
+    "cvar tracking",
+    "team map data",
+    "landmines",
+    "banners",
+    "binoc war",
+    "crazy gravity",
+    "airstrikes",
+    "database",
+    "client think",
+    "client command",
+    "bot update",
+};
+
+typedef char StageNamesCheck[ sizeof(STAGE_NAMES) / sizeof(STAGE_NAMES[0]) == FrameProfiler::NUM_STAGES ? 1 : -1 ];
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+FrameProfiler::Stopwatch::Stopwatch( Stage stage_ )
+    : _stage  ( stage_ )
+    , _active ( cvars::g_perf.ivalue != 0 )
+    , _begin  ( 0 )
+    , _lap    ( 0 )
+{
+    if (!_active)
+        return;
+
+    _begin = process.ustime();
+    _lap   = _begin;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+FrameProfiler::Stopwatch::~Stopwatch()
+{
+    if (!_active)
+        return;
+
+    // Clamp: a clock step backwards must not wrap to a huge sample.
+    const Process::ustime_t now = process.ustime();
+    frameProfiler.add( _stage, now > _begin ? now - _begin : 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+FrameProfiler::Stopwatch::lap( Stage stage )
+{
+    if (!_active)
+        return;
+
+    const Process::ustime_t now = process.ustime();
+    frameProfiler.add( stage, now > _lap ? now - _lap : 0 );
+    _lap = now;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+FrameProfiler::FrameProfiler()
+{
+    // 6 buckets: the period slides in 10 second steps
+    for ( int i = 0; i < NUM_STAGES; i++ )
+        _stats[i] = new SampledStat( PERIOD, 6 );
+
+    memset( _pending, 0, sizeof(_pending) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+FrameProfiler::~FrameProfiler()
+{
+    for ( int i = 0; i < NUM_STAGES; i++ )
+        delete _stats[i];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+FrameProfiler::add( Stage stage, Process::ustime_t usec )
+{
+    _pending[stage] += usec;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+FrameProfiler::cvarPerf( Cvar& var )
+{
+    // start a fresh window whenever profiling is switched on or off
+    frameProfiler.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+FrameProfiler::frameEnd()
+{
+    if (!cvars::g_perf.ivalue)
+        return;
+
+    for ( int i = 0; i < NUM_STAGES; i++ ) {
+        _stats[i]->sample( float( _pending[i] ));
+        _pending[i] = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+FrameProfiler::frames() const
+{
+    return _stats[FRAME]->count();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char*
+FrameProfiler::name( Stage stage )
+{
+    return STAGE_NAMES[stage];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+FrameProfiler::reset()
+{
+    for ( int i = 0; i < NUM_STAGES; i++ )
+        _stats[i]->reset();
+
+    memset( _pending, 0, sizeof(_pending) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+FrameProfiler::summarize( Stage stage, Summary& out ) const
+{
+    const SampledStat& stat = *_stats[stage];
+
+    out.p50 = uint32( stat.quantile( 0.50f ));
+    out.p95 = uint32( stat.quantile( 0.95f ));
+    out.p99 = uint32( stat.quantile( 0.99f ));
+    out.max = stat.peak();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+FrameProfiler frameProfiler;
@@ -0,0 +1,100 @@
+#ifndef GAME_FRAMEPROFILER_H
+#define GAME_FRAMEPROFILER_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * FrameProfiler records microseconds spent per server frame in each stage
+ * of G_RunFrame and in the per-client entry points called between frames.
+ *
+ * Time is accumulated per stage until frameEnd(), which samples each total
+ * into a SampledStat covering the last PERIOD milliseconds. Nothing is
+ * timed unless g_perf is set, so a disabled Stopwatch costs one cvar read.
+ */
+class FrameProfiler
+{
+public:
+    enum Stage {
+        FRAME,          // all of G_RunFrame
+        HOUSEKEEPING,   // reload/shutdown signals, ammo table, uptime
+        CVARS,
+        MOLOTOV,
+        ENTITIES,
+        GHOSTPRUNE,
+        CLIENTS,
+        DEFERRED,
+        WOLFMP,
+        EXITRULES,
+        TEAMSTATUS,
+        VOTE,
+        CVARTRACK,
+        TEAMMAPDATA,
+        LANDMINES,
+        BANNERS,
+        BINOCWAR,
+        CRAZYGRAVITY,
+        AIRSTRIKES,
+        DATABASE,
+        CLIENTTHINK,    // vmMain entry points, summed over the frame
+        CLIENTCOMMAND,
+        BOTUPDATE,
+        NUM_STAGES
+    };
+
+    enum { PERIOD = 60*1000 };  // milliseconds of frames summarized
+
+    /*
+     * Times one stage from construction to destruction. lap() closes the
+     * current interval into a stage and starts the next, for sequential
+     * stages; the constructor's stage receives the whole lifetime.
+     */
+    class Stopwatch {
+    private:
+        Stage             _stage;
+        bool              _active;
+        Process::ustime_t _begin;
+        Process::ustime_t _lap;
+
+    public:
+        Stopwatch( Stage );
+        ~Stopwatch();
+
+        void lap( Stage );
+    };
+
+    struct Summary {
+        uint32 p50;
+        uint32 p95;
+        uint32 p99;
+        uint32 max;
+    };
+
+private:
+    Process::ustime_t _pending[NUM_STAGES];  // usec since last frameEnd
+    SampledStat*      _stats[NUM_STAGES];    // usec per frame
+
+    FrameProfiler( const FrameProfiler& );             // not copyable
+    FrameProfiler& operator=( const FrameProfiler& );
+
+public:
+    FrameProfiler();
+    ~FrameProfiler();
+
+    void add      ( Stage, Process::ustime_t );
+    void frameEnd ( );  // close frame; called before each G_RunFrame
+    void reset    ( );
+
+    uint32 frames    ( ) const;  // frames in period
+    void   summarize ( Stage, Summary& ) const;
+
+    static const char* name     ( Stage );
+    static void        cvarPerf ( Cvar& );  // cvar-changed callback
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+extern FrameProfiler frameProfiler;
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_FRAMEPROFILER_H
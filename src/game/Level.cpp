@@ -25,14 +25,10 @@ Level::~Level()
 ///////////////////////////////////////////////////////////////////////////////
 
 void
-Level::decode( map<string,string>& data )
+Level::decode( const DatabaseRecord& rec )
 {
-    stringstream ss;
-
     // Level
-    ss.str("");
-    ss << data["level"];
-    ss >> _level;
+    _level = int( rec.toInt( FIELD_LEVEL ));
 
     if (_level < 0)
         _level = 0;
@@ -40,10 +36,10 @@ Level::decode( map<string,string>& data )
         _level = 0;
 
     // MIKE TODO: for 2.1.7 release we can remove concat'd PRIVILEGES
-    PrivilegeSet::decode( privGranted, privDenied, data["acl"] + ' ' + data["privileges"], data["flags"] );
+    PrivilegeSet::decode( privGranted, privDenied, rec.str( FIELD_ACL ) + ' ' + rec.str( FIELD_PRIVILEGES ), rec.str( FIELD_FLAGS ));
 
-    name = data["name"];
-    namex = data["namex"];
+    name = rec.get( FIELD_NAME );
+    namex = rec.get( FIELD_NAMEX );
 
     // namex has priority
     if (namex.empty())
@@ -54,8 +50,8 @@ Level::decode( map<string,string>& data )
     str::etDecolorize( name );
 
     // Greeting
-    greetingText = data["greetingtext"];
-    greetingAudio = data["greetingaudio"];
+    greetingText = rec.get( FIELD_GREETINGTEXT );
+    greetingAudio = rec.get( FIELD_GREETINGAUDIO );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -119,6 +115,22 @@ Level::operator=( const Level& lev )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+    const char* const fieldNames[] = {
+        "level",
+        "acl",
+        "privileges",
+        "flags",
+        "name",
+        "namex",
+        "greetingtext",
+        "greetingaudio",
+        NULL,
+    };
+} // namespace anonymous
+
+const DatabaseSchema Level::schema( fieldNames );
+
 Level Level::BAD;
 Level Level::DEFAULT;
 
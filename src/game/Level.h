@@ -38,9 +38,22 @@ public:
     PrivilegeSet privDenied;   // denied privileges
 
 private:
-    void decode( map<string,string>& data );  // decodes record from database
+    enum Field {
+        FIELD_LEVEL,
+        FIELD_ACL,
+        FIELD_PRIVILEGES,
+        FIELD_FLAGS,
+        FIELD_NAME,
+        FIELD_NAMEX,
+        FIELD_GREETINGTEXT,
+        FIELD_GREETINGAUDIO,
+    };
+
+    void decode( const DatabaseRecord& );  // decodes record from database
     void encode( ostream&, int );  // encodes record to database
 
+    static const DatabaseSchema schema;  // field names for decode
+
 public:
     static Level BAD;
     static Level DEFAULT;
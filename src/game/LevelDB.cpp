@@ -2,6 +2,32 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+struct LevelDB::Snapshot : public DatabaseWriter::Job
+{
+    string     header;
+    mapLEVEL_t records;
+
+    Snapshot( const string& filename )
+        : Job( filename, "levels" )
+    {
+    }
+
+    int write( ostream& out )
+    {
+        out << header;
+
+        int recnum = 0;
+        const mapLEVEL_t::iterator max = records.end();
+        for ( mapLEVEL_t::iterator it = records.begin(); it != max; it++ )
+            it->second.encode( out, recnum++ );
+
+        out << '\n';
+        return recnum;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 LevelDB::LevelDB()
     : Database ( "level.db", "level" )
     , mapLEVEL ( _mapLEVEL )
@@ -122,35 +148,33 @@ LevelDB::load()
 
     // Open file
     string filename;
-    if (open( false, filename ))
+    if (open( filename ))
         return;
 
     logBegin( false, filename );
 
-    // parse DEFAULT user information
-    map<string,string> data;
+    DatabaseRecord rec( Level::schema );
 
     // Parse each record
-    while (!_stream.rdstate()) {
-        parseData( data );
+    while (!atEnd()) {
+        parseRecord( rec );
 
-        map<string,string>::const_iterator it = data.find( _key );
-        if (it == data.end())
+        if (!rec.has( Level::FIELD_LEVEL ))
             continue;
 
-        const int reckey = toKey( it->second );
+        const int reckey = toKey( rec.get( Level::FIELD_LEVEL ));
 
         string err;
         Level& level = fetchByKey( reckey, err, true );
         if (level == Level::BAD) {
             ostringstream msg;
-            msg << "WARNING: skipping invalid LEVEL record: " << it->second << endl;
+            msg << "WARNING: skipping invalid LEVEL record: " << rec.get( Level::FIELD_LEVEL ) << endl;
             trap_Printf( msg.str().c_str() );
             _mapLEVEL.erase( reckey );
             continue;
         }
 
-        level.decode( data );
+        level.decode( rec );
     }
 
     logEnd( _mapLEVEL.size(), "levels" );
@@ -172,36 +196,29 @@ LevelDB::remove( Level& obj, const Level& migrate )
 void
 LevelDB::save()
 {
-    // Open file
-    string filename;
-    if ( open( true, filename ) )
-        return;
-
-    logBegin( true, filename );
+    const Process::ustime_t begin = process.ustime();
 
     time_t now = time( 0 );
     char fnow[32];
     strftime( fnow, sizeof(fnow), "%c", localtime( &now ));
 
+    Snapshot* const snap = new Snapshot( pathname( _filename ));
+
     // Output header
-    _stream << "###############################################################################"
+    ostringstream header;
+    header << "###############################################################################"
         << '\n' << "##"
         << '\n' << "## " << JAYMOD_title << " -- " << _filename
         << '\n' << "## updated: " << fnow
         << '\n' << "## levels:  " << _mapLEVEL.size()
         << '\n' << "##"
         << '\n' << "###############################################################################";
+    snap->header = header.str();
 
-    // Output users
-    int recnum = 0;
-    const mapLEVEL_t::iterator max = _mapLEVEL.end();
-    for ( mapLEVEL_t::iterator it = _mapLEVEL.begin(); it != max; it++ )
-        it->second.encode( _stream, recnum++ );
-
-    _stream << '\n';
+    snap->records = _mapLEVEL;
+    snap->capture = process.ustime() - begin;
 
-    logEnd( _mapLEVEL.size(), "levels" );
-    close();
+    dbWriter.submit( snap );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
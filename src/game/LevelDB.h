@@ -8,6 +8,8 @@ public:
     typedef map<int,Level> mapLEVEL_t;
 
 private:
+    struct Snapshot;  // records captured for dbWriter; see LevelDB.cpp
+
     mapLEVEL_t _mapLEVEL; // memory-map for all records
 
 public:
@@ -2,6 +2,32 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+struct MapDB::Snapshot : public DatabaseWriter::Job
+{
+    string    header;
+    mapNAME_t records;
+
+    Snapshot( const string& filename )
+        : Job( filename, "maps" )
+    {
+    }
+
+    int write( ostream& out )
+    {
+        out << header;
+
+        int recnum = 0;
+        const mapNAME_t::iterator max = records.end();
+        for ( mapNAME_t::iterator it = records.begin(); it != max; it++ )
+            it->second.encode( out, recnum++ );
+
+        out << '\n';
+        return recnum;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 MapDB::MapDB()
     : Database ( "map.db", "name" )
     , mapNAME  ( _mapNAME )
@@ -51,32 +77,33 @@ MapDB::load()
     _mapNAME.clear();
 
     string filename;
-    if (open( false, filename ))
+    if (open( filename ))
         return;
 
     logBegin( false, filename );
 
-    map<string,string> data;
+    DatabaseRecord rec( MapRecord::schema );
 
     // parse each record
-    while ( !_stream.rdstate() ) {
-        parseData( data );
+    while ( !atEnd() ) {
+        parseRecord( rec );
 
-        map<string,string>::const_iterator it = data.find( _key );
-        if ( it == data.end() )
+        if ( !rec.has( MapRecord::FIELD_NAME ))
             continue;
 
+        const string key = rec.str( MapRecord::FIELD_NAME );
+
         string err;
-        MapRecord& mapRecord = fetchByKey( it->second, err, true );
+        MapRecord& mapRecord = fetchByKey( key, err, true );
         if ( mapRecord.isNull() ) {
             ostringstream msg;
-            msg << "WARNING: skipping invalid map record: " << it->second << endl;
+            msg << "WARNING: skipping invalid map record: " << key << endl;
             trap_Printf( msg.str().c_str() );
-            _mapNAME.erase( it->second );
+            _mapNAME.erase( key );
             continue;
         }
 
-        mapRecord.decode( data );
+        mapRecord.decode( rec );
     }
 
     logEnd( _mapNAME.size(), "maps" );
@@ -88,19 +115,17 @@ MapDB::load()
 void
 MapDB::save()
 {
-    // Open file
-    string filename;
-    if ( open( true, filename ) )
-        return;
-
-    logBegin( true, filename );
+    const Process::ustime_t begin = process.ustime();
 
     time_t now = time( 0 );
     char fnow[32];
     strftime( fnow, sizeof(fnow), "%c", localtime( &now ));
 
+    Snapshot* const snap = new Snapshot( pathname( _filename ));
+
     // Output header
-    _stream
+    ostringstream header;
+    header
         << "###############################################################################"
         << '\n' << "##"
         << '\n' << "## " << JAYMOD_title << " -- " << _filename
@@ -108,20 +133,12 @@ MapDB::save()
         << '\n' << "## records: " << _mapNAME.size()
         << '\n' << "##"
         << '\n' << "###############################################################################";
+    snap->header = header.str();
 
-    int recnum = 0;
+    snap->records = _mapNAME;
+    snap->capture = process.ustime() - begin;
 
-    // Output maps
-    const mapNAME_t::iterator max = _mapNAME.end();
-    for ( mapNAME_t::iterator it = _mapNAME.begin(); it != max; it++ ) {
-        // Write the record
-        it->second.encode( _stream, recnum++ );
-    }
-
-    _stream << '\n';
-
-    logEnd( _mapNAME.size(), "maps" );
-    close();
+    dbWriter.submit( snap );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
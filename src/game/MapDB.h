@@ -8,6 +8,8 @@ public:
     typedef map<const string,MapRecord> mapNAME_t;
 
 private:
+    struct Snapshot;  // records captured for dbWriter; see MapDB.cpp
+
     mapNAME_t _mapNAME;
 
 public:
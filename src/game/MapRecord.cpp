@@ -30,38 +30,27 @@ MapRecord::~MapRecord()
 ///////////////////////////////////////////////////////////////////////////////
 
 void
-MapRecord::decode( map<string,string>& data )
+MapRecord::decode( const DatabaseRecord& rec )
 {
     // Timestamp
-    stringstream ss;
-    ss << data["timestamp"];
-    ss >> timestamp;
+    timestamp = time_t( rec.toInt( FIELD_TIMESTAMP ));
     if (timestamp < 0)
         timestamp = 0;
 
     // Map counter
-    ss.str("");
-    ss.clear();
-    ss << data["count"];
-    ss >> count;
+    count = long( rec.toInt( FIELD_COUNT ));
     if (count < 0)
         count = 0;
 
     // Longest Killing Spree
-    ss.str("");
-    ss.clear();
-    ss << data["longestspree"];
-    ss >> longestSpree;
+    longestSpree = int( rec.toInt( FIELD_LONGESTSPREE ));
     if (longestSpree > 0) {
         // Timestamp
-        ss.str("");
-        ss.clear();
-        ss << data["longestspreetime"];
-        ss >> longestSpreeTime;
+        longestSpreeTime = time_t( rec.toInt( FIELD_LONGESTSPREETIME ));
 
         // Name
-        longestSpreeName = data["longestspreename"];
-        longestSpreeNamex = data["longestspreenamex"];
+        longestSpreeName = rec.get( FIELD_LONGESTSPREENAME );
+        longestSpreeNamex = rec.get( FIELD_LONGESTSPREENAMEX );
     }
 }
 
@@ -77,7 +66,8 @@ MapRecord::encode( ostream& out, int recnum )
     out << '\n' << "name = " << name;
 
     char ftbuf[32];
-    strftime( ftbuf, sizeof(ftbuf), "%c", localtime( &timestamp ));
+    tm ltm;
+    strftime( ftbuf, sizeof(ftbuf), "%c", process.localtime( timestamp, ltm ));
 
     out << '\n' << "timestamp = " << timestamp << " # " << ftbuf;
     out << '\n' << "count = " << count;
@@ -85,7 +75,7 @@ MapRecord::encode( ostream& out, int recnum )
     if (longestSpree > 0) {
         out << '\n' << "longestspree = " << longestSpree;
 
-        strftime( ftbuf, sizeof(ftbuf), "%c", localtime( &longestSpreeTime ));
+        strftime( ftbuf, sizeof(ftbuf), "%c", process.localtime( longestSpreeTime, ltm ));
         out << '\n' << "longestspreetime = " << longestSpreeTime << " # " << ftbuf;
 
         out << '\n' << "longestspreename = " << longestSpreeName;
@@ -130,4 +120,19 @@ MapRecord::isNull()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+    const char* const fieldNames[] = {
+        "name",
+        "timestamp",
+        "count",
+        "longestspree",
+        "longestspreetime",
+        "longestspreename",
+        "longestspreenamex",
+        NULL,
+    };
+} // namespace anonymous
+
+const DatabaseSchema MapRecord::schema( fieldNames );
+
 MapRecord MapRecord::BAD;
@@ -36,10 +36,22 @@ public:
     bool           operator==( const MapRecord& mapRecord ) const;
 
 private:
-    void  decode ( map<string,string>& );
+    enum Field {
+        FIELD_NAME,
+        FIELD_TIMESTAMP,
+        FIELD_COUNT,
+        FIELD_LONGESTSPREE,
+        FIELD_LONGESTSPREETIME,
+        FIELD_LONGESTSPREENAME,
+        FIELD_LONGESTSPREENAMEX,
+    };
+
+    void  decode ( const DatabaseRecord& );
     void  encode ( ostream&, int );
     bool  isNull ( );
 
+    static const DatabaseSchema schema;  // field names for decode
+
 public:
     static MapRecord BAD;
 };
@@ -0,0 +1,18 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+MappedFile::MappedFile()
+    : _data ( 0 )
+    , _size ( 0 )
+    , data  ( _data )
+    , size  ( _size )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+MappedFile::~MappedFile()
+{
+    close();
+}
@@ -0,0 +1,38 @@
+#ifndef GAME_MAPPEDFILE_H
+#define GAME_MAPPEDFILE_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Read-only memory mapping of an entire file. Data remains valid until
+ * close() or destruction.
+ */
+class MappedFile
+{
+private:
+    const char* _data;
+    size_t      _size;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /**************************************************************************
+     * Map file.
+     *
+     * Param fname specifies full pathname.
+     *
+     * Returns true if error ocurred (including empty file).
+     *
+     */
+    bool open( const string& fname );
+
+    void close();
+
+    const char* const& data;
+    const size_t&      size;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_MAPPEDFILE_H
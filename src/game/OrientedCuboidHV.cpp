@@ -9,6 +9,10 @@ OrientedCuboidHV::OrientedCuboidHV( zone_t zone_, AbstractHitModel& hitModel_, s
     memset( scale, 0, sizeof(scale) );
     memset( axis, 0, sizeof(axis) );
     memset( coords, 0, sizeof(coords) );
+
+    memset( _slabNormal, 0, sizeof(_slabNormal) );
+    memset( _slabMin, 0, sizeof(_slabMin) );
+    memset( _slabMax, 0, sizeof(_slabMax) );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -29,6 +33,10 @@ OrientedCuboidHV::operator=( const OrientedCuboidHV& obj )
     memcpy( axis, obj.axis, sizeof(axis ));
     memcpy( coords, obj.coords, sizeof(coords ));
 
+    memcpy( _slabNormal, obj._slabNormal, sizeof(_slabNormal ));
+    memcpy( _slabMin, obj._slabMin, sizeof(_slabMin ));
+    memcpy( _slabMax, obj._slabMax, sizeof(_slabMax ));
+
     return *this;
 }
 
@@ -37,6 +45,15 @@ OrientedCuboidHV::operator=( const OrientedCuboidHV& obj )
 bool
 OrientedCuboidHV::castRay( TraceContext& trx, vec3_t& rpos, float& rlen )
 {
+    // Broad-phase: skip the 12 triangle tests when the ray cannot touch this volume.
+    // Not applied while debugging this zone so per-face output remains complete.
+    const bool doDebug =
+        (cvars::g_hitmodeDebug.ivalue & AbstractHitModel::DEBUG_TVOLUME) &&
+        (cvars::g_hitmodeZone.ivalue == zone);
+
+    if (!doDebug && !lineIntersects( trx ))
+        return false;
+
     vec3_t tmppos;
     float  tmplen;
 
@@ -122,7 +139,7 @@ OrientedCuboidHV::castRayTriangle(
     TraceContext&  trx,
     vec3_t&        rpos,
     float&         rlen,
-    const string&  name,
+    const char*    name,
     const vec3_t&  p0,
     const vec3_t&  p1,
     const vec3_t&  p2 )
@@ -148,7 +165,7 @@ OrientedCuboidHV::castRayTriangle(
         colA.width = 9;
         colA.suffixOutside = " = "; 
 
-        trx.debug << xheader( JAYMOD_FUNCTION )
+        trx.debug() << xheader( JAYMOD_FUNCTION )
             << "\n(" << xcpush << xcheader << " zone=" << xvalueBOLD( toString( zone ))
                                            << " type=" << xvalueBOLD( toString( type ))
                                            << " face=" << xvalueBOLD( name )
@@ -165,11 +182,11 @@ OrientedCuboidHV::castRayTriangle(
     float a = DotProduct( e1, h );
 
     if (doDebug)
-        trx.debug << "\n" << colA( "a" ) << xvalue( a );
+        trx.debug() << "\n" << colA( "a" ) << xvalue( a );
 
     if (a == 0.0f) {
         if (doDebug)
-            trx.debug << "\n" << colA( "pruned" ) << xvalue( "a is 0" ) << xlunindent << "\n";
+            trx.debug() << "\n" << colA( "pruned" ) << xvalue( "a is 0" ) << xlunindent << "\n";
         return false;
     }
 
@@ -180,11 +197,11 @@ OrientedCuboidHV::castRayTriangle(
     float u = f * DotProduct( s, h );
 
     if (doDebug)
-        trx.debug << "\n" << colA( "u" ) << xvalue( u );
+        trx.debug() << "\n" << colA( "u" ) << xvalue( u );
 
     if (u < 0.0f || u > 1.0f) {
         if (doDebug)
-            trx.debug << "\n" << colA( "pruned" ) << xvalue( "u out of range" ) << xlunindent << "\n";
+            trx.debug() << "\n" << colA( "pruned" ) << xvalue( "u out of range" ) << xlunindent << "\n";
         return false;
     }
 
@@ -193,18 +210,18 @@ OrientedCuboidHV::castRayTriangle(
     float v = f * DotProduct( dray, q );
 
     if (doDebug)
-        trx.debug << "\n" << colA( "v" ) << xvalue( v );
+        trx.debug() << "\n" << colA( "v" ) << xvalue( v );
 
     if (v < 0.0f || u+v > 1.0f) {
         if (doDebug)
-            trx.debug << "\n" << colA( "pruned" ) << xvalue( "v out of range" ) << xlunindent << "\n";
+            trx.debug() << "\n" << colA( "pruned" ) << xvalue( "v out of range" ) << xlunindent << "\n";
         return false;
     }
 
     float t = f * DotProduct( e2, q );
 
     if (doDebug)
-        trx.debug << "\n" << colA( "t" ) << xvalue( t );
+        trx.debug() << "\n" << colA( "t" ) << xvalue( t );
 
     if (t == 0.0f)
         return false;
@@ -214,7 +231,7 @@ OrientedCuboidHV::castRayTriangle(
 
     if (doDebug) {
         colA.color = xcdebugBOLD;
-        trx.debug << "\n" << colA( "rlen" ) << xvalue( rlen )
+        trx.debug() << "\n" << colA( "rlen" ) << xvalue( rlen )
                   << "\n" << colA( "rpos" ) << xvec3 ( rpos )
                   << xlunindent << "\n";
     }
@@ -224,6 +241,56 @@ OrientedCuboidHV::castRayTriangle(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ * Conservative slab test of the infinite line through trx against this cuboid.
+ * castRayTriangle accepts any non-zero t, hence line rather than segment.
+ * Slabs are padded so float error can never reject a ray which the triangle
+ * tests would accept; a false result guarantees castRay misses.
+ */
+bool
+OrientedCuboidHV::lineIntersects( const TraceContext& trx ) const
+{
+    vec3_t dray;
+    VectorSubtract( trx.end, trx.start, dray );
+
+    float tmin = -FLT_MAX;
+    float tmax = FLT_MAX;
+
+    for (int k = 0; k < 3; k++) {
+        const float lo = _slabMin[k];
+        const float hi = _slabMax[k];
+
+        const float p = DotProduct( _slabNormal[k], trx.start );
+        const float d = DotProduct( _slabNormal[k], dray );
+
+        if (d == 0.0f) {
+            if (p < lo || p > hi)
+                return false;
+            continue;
+        }
+
+        float t0 = (lo - p) / d;
+        float t1 = (hi - p) / d;
+        if (t0 > t1) {
+            const float tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+
+        if (t0 > tmin)
+            tmin = t0;
+        if (t1 < tmax)
+            tmax = t1;
+
+        if (tmin > tmax)
+            return false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 OrientedCuboidHV::doEntityCompute()
 {
@@ -290,4 +357,55 @@ OrientedCuboidHV::reorient()
         else if (v[2] > maxs[2])
             maxs[2] = v[2];
     }
+
+    // Slab k is bounded by the two faces spanned by the other axes.
+    for (int k = 0; k < 3; k++) {
+        vec3_t& n = _slabNormal[k];
+        CrossProduct( axis[(k+1)%3], axis[(k+2)%3], n );
+
+        // Degenerate axes: accept everything along this normal.
+        if (VectorNormalize( n ) == 0.0f) {
+            _slabMin[k] = -FLT_MAX;
+            _slabMax[k] = FLT_MAX;
+            continue;
+        }
+
+        float lo = 0.0f;
+        float hi = scale[k] * DotProduct( n, axis[k] );
+        if (lo > hi) {
+            lo = hi;
+            hi = 0.0f;
+        }
+
+        const float pad  = 0.01f * (hi - lo) + 0.25f;
+        const float base = DotProduct( n, origin );
+        _slabMin[k] = base + lo - pad;
+        _slabMax[k] = base + hi + pad;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+OrientedCuboidHV::restore( const record_t& rec )
+{
+    VectorCopy( rec.origin, origin );
+    VectorCopy( rec.scale, scale );
+    memcpy( axis, rec.axis, sizeof(axis) );
+
+    // Rebuild coords from transform; recorded bounds then take precedence.
+    reorient();
+    AbstractHitVolume::restore( rec );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+OrientedCuboidHV::save( record_t& rec ) const
+{
+    AbstractHitVolume::save( rec );
+
+    VectorCopy( origin, rec.origin );
+    VectorCopy( scale, rec.scale );
+    memcpy( rec.axis, axis, sizeof(rec.axis) );
 }
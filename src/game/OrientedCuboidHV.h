@@ -10,13 +10,20 @@ protected:
         TraceContext&,  // standard trace context
         vec3_t&,        // result: position of hit
         float&,         // result: length of hit-ray
-        const string&,  // name of face/plane
+        const char*,    // name of face/plane
         const vec3_t&,
         const vec3_t&,
         const vec3_t& );
 
+    bool lineIntersects( const TraceContext& ) const;
+
     void doEntityCompute();
 
+    // Padded slabs for lineIntersects(), rebuilt by reorient().
+    vec3_t _slabNormal[3];
+    float  _slabMin[3];
+    float  _slabMax[3];
+
 public:
     OrientedCuboidHV( zone_t, AbstractHitModel&, scope_t );
     ~OrientedCuboidHV();
@@ -25,6 +32,8 @@ public:
 
     bool castRay  ( TraceContext&, vec3_t&, float& );
     void reorient ( );
+    void restore  ( const record_t& );
+    void save     ( record_t& ) const;
 
     vec3_t origin;
     vec3_t scale;
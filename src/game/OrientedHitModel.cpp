@@ -26,13 +26,19 @@ OrientedHitModel::~OrientedHitModel()
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void
-OrientedHitModel::doRun()
+bool
+OrientedHitModel::doCapture( grefEntity_t& re )
 {
-    // Fetch origins/orientations for player model.   
-    grefEntity_t re;
     mdx_gentity_to_grefEntity( &client.gentity, &re, time );
+    return true;
+}
 
+///////////////////////////////////////////////////////////////////////////////
+
+void
+OrientedHitModel::doPose( grefEntity_t& re )
+{
+    // Fetch origins/orientations for player model.
     vec3_t        origins[MRP_MAX];
     orientation_t orients[MRP_MAX];
     mdx_advanced_positions( client.gentity, re, origins, orients );
@@ -291,6 +297,16 @@ OrientedHitModel::doRun()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void
+OrientedHitModel::doRun()
+{
+    grefEntity_t re;
+    doCapture( re );
+    doPose( re );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 OrientedHitModel&
 OrientedHitModel::operator=( const OrientedHitModel& obj )
 {
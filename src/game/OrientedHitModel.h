@@ -14,6 +14,8 @@ private:
     OrientedHitModel();
 
 protected:
+    bool              doCapture  ( grefEntity_t& );
+    void              doPose     ( grefEntity_t& );
     void              doRun      ( );
     OrientedHitModel* doSnapshot ( );
 
@@ -0,0 +1,285 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char HEX[] = "0123456789abcdef";
+
+///////////////////////////////////////////////////////////////////////////////
+
+int
+hexValue( char c )
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+PackedAddress::PackedAddress()
+    : _kind ( KIND_EMPTY )
+{
+    memset( _data, 0, sizeof(_data) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PackedAddress::PackedAddress( const string& s )
+    : _kind ( KIND_EMPTY )
+{
+    memset( _data, 0, sizeof(_data) );
+    operator=( s );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+PackedAddress::clear()
+{
+    _kind = KIND_EMPTY;
+    _text.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PackedAddress::empty() const
+{
+    return _kind == KIND_EMPTY;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+string::size_type
+PackedAddress::find( const string& s, string::size_type pos ) const
+{
+    return str().find( s, pos );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PackedAddress::operator string() const
+{
+    return str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PackedAddress&
+PackedAddress::operator=( const string& s )
+{
+    _text.clear();
+
+    if (s.empty())
+        _kind = KIND_EMPTY;
+    else if (packIPv4( s ))
+        _kind = KIND_IPV4;
+    else if (packMAC( s ))
+        _kind = s[2] == ':' ? KIND_MAC_COLON : KIND_MAC_DASH;
+    else {
+        _kind = KIND_TEXT;
+        _text = s;
+    }
+
+    return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PackedAddress&
+PackedAddress::operator=( const char* s )
+{
+    return operator=( string( s ));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PackedAddress::operator==( const PackedAddress& ref ) const
+{
+    if (_kind != ref._kind)
+        return false;
+
+    switch (_kind) {
+        case KIND_EMPTY:
+            return true;
+
+        case KIND_IPV4:
+            return !memcmp( _data, ref._data, 4 );
+
+        case KIND_TEXT:
+            return _text == ref._text;
+
+        default:
+            return !memcmp( _data, ref._data, 6 );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PackedAddress::operator!=( const PackedAddress& ref ) const
+{
+    return !operator==( ref );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PackedAddress::operator<( const PackedAddress& ref ) const
+{
+    if (_kind != ref._kind)
+        return _kind < ref._kind;
+
+    switch (_kind) {
+        case KIND_EMPTY:
+            return false;
+
+        case KIND_IPV4:
+            return memcmp( _data, ref._data, 4 ) < 0;
+
+        case KIND_TEXT:
+            return _text < ref._text;
+
+        default:
+            return memcmp( _data, ref._data, 6 ) < 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PackedAddress::packIPv4( const string& s )
+{
+    const char* p = s.c_str();
+    uint8 octets[4];
+
+    for ( int i = 0; i < 4; i++ ) {
+        if (i > 0 && *p++ != '.')
+            return false;
+
+        // no leading zeros, so the text round-trips
+        if (*p < '0' || *p > '9' || (p[0] == '0' && p[1] >= '0' && p[1] <= '9'))
+            return false;
+
+        int value = 0;
+        for ( int digits = 0; *p >= '0' && *p <= '9'; p++ ) {
+            if (++digits > 3)
+                return false;
+            value = value * 10 + (*p - '0');
+        }
+
+        if (value > 255)
+            return false;
+
+        octets[i] = uint8( value );
+    }
+
+    if (*p)
+        return false;
+
+    memcpy( _data, octets, 4 );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PackedAddress::packMAC( const string& s )
+{
+    if (s.length() != 17)
+        return false;
+
+    const char sep = s[2];
+    if (sep != ':' && sep != '-')
+        return false;
+
+    uint8 bytes[6];
+    for ( int i = 0; i < 6; i++ ) {
+        const char* const p = s.c_str() + i * 3;
+
+        if (i > 0 && p[-1] != sep)
+            return false;
+
+        const int hi = hexValue( p[0] );
+        const int lo = hexValue( p[1] );
+        if (hi < 0 || lo < 0)
+            return false;
+
+        bytes[i] = uint8( (hi << 4) | lo );
+    }
+
+    memcpy( _data, bytes, 6 );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PackedAddress::packed() const
+{
+    return _kind == KIND_IPV4 || _kind == KIND_MAC_COLON || _kind == KIND_MAC_DASH;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+string
+PackedAddress::str() const
+{
+    switch (_kind) {
+        case KIND_EMPTY:
+            return string();
+
+        case KIND_IPV4:
+        {
+            char buf[16];
+            sprintf( buf, "%u.%u.%u.%u", _data[0], _data[1], _data[2], _data[3] );
+            return buf;
+        }
+
+        case KIND_TEXT:
+            return _text.str();
+
+        default:
+        {
+            const char sep = _kind == KIND_MAC_COLON ? ':' : '-';
+
+            char buf[18];
+            char* p = buf;
+            for ( int i = 0; i < 6; i++ ) {
+                if (i > 0)
+                    *p++ = sep;
+                *p++ = HEX[ _data[i] >> 4 ];
+                *p++ = HEX[ _data[i] & 0x0f ];
+            }
+            *p = '\0';
+            return buf;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const PooledString&
+PackedAddress::text() const
+{
+    return _text;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ostream&
+operator<<( ostream& out, const PackedAddress& address )
+{
+    return out << address.str();
+}
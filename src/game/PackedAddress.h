@@ -0,0 +1,66 @@
+#ifndef GAME_PACKEDADDRESS_H
+#define GAME_PACKEDADDRESS_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * PackedAddress stores an IPv4 or MAC address string in binary form when
+ * the text can be reproduced exactly from it: dotted-quad without leading
+ * zeros, or six lowercase hex pairs separated by ':' or '-'. Anything else
+ * (subnet bans, "localhost") is kept as a PooledString.
+ *
+ * Text is rebuilt on each access, so callers receive string values rather
+ * than references.
+ */
+class PackedAddress
+{
+private:
+    enum Kind {
+        KIND_EMPTY,
+        KIND_IPV4,
+        KIND_MAC_COLON,
+        KIND_MAC_DASH,
+        KIND_TEXT,
+    };
+
+    uint8        _kind;
+    uint8        _data[6];
+    PooledString _text;     // KIND_TEXT only
+
+    bool packIPv4 ( const string& );
+    bool packMAC  ( const string& );
+
+public:
+    PackedAddress();
+    PackedAddress( const string& );
+
+    PackedAddress& operator= ( const string& );
+    PackedAddress& operator= ( const char* );
+
+    bool operator== ( const PackedAddress& ) const;
+    bool operator!= ( const PackedAddress& ) const;
+    bool operator<  ( const PackedAddress& ) const;  // arbitrary but consistent with ==
+
+    operator string() const;
+
+    void              clear ( );
+    bool              empty ( ) const;
+    string::size_type find  ( const string&, string::size_type = 0 ) const;
+    string            str   ( ) const;
+
+    const PooledString& text() const;  // unpacked form, empty when packed
+
+    /**************************************************************************
+     * Returns true if stored in binary form.
+     *
+     */
+    bool packed() const;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+ostream& operator<<( ostream&, const PackedAddress& );
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_PACKEDADDRESS_H
@@ -0,0 +1,355 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString::PooledString()
+    : _entry ( NULL )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString::PooledString( const PooledString& ref )
+    : _entry ( ref._entry )
+{
+    if (_entry)
+        _entry->refs++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString::PooledString( const string& s )
+    : _entry ( NULL )
+{
+    assign( s.data(), s.length() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString::PooledString( const char* s )
+    : _entry ( NULL )
+{
+    assign( s, strlen( s ));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString::~PooledString()
+{
+    release();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+PooledString::assign( const char* s, size_t length )
+{
+    if (!length) {
+        release();
+        return;
+    }
+
+    const uint32 h = hash( s, length );
+
+    Entry* found = NULL;
+    if (_buckets) {
+        for ( Entry* e = _buckets[ h & _mask ]; e; e = e->next ) {
+            if (e->hash == h && e->length == length && !memcmp( e->data, s, length )) {
+                found = e;
+                break;
+            }
+        }
+    }
+
+    if (found) {
+        if (found == _entry)
+            return;
+
+        found->refs++;
+        release();
+        _entry = found;
+        return;
+    }
+
+    // Copy before release, s may point into the entry being released.
+    const size_t size = offsetof( Entry, data ) + length + 1;
+    Entry* const e = static_cast<Entry*>( malloc( size ));
+    e->hash   = h;
+    e->refs   = 1;
+    e->length = uint32( length );
+    memcpy( e->data, s, length );
+    e->data[length] = '\0';
+
+    release();
+
+    if (!_buckets)
+        rehash( 256 );
+    else if (_count >= _mask + 1)
+        rehash( (_mask + 1) * 2 );
+
+    Entry*& head = _buckets[ h & _mask ];
+    e->next = head;
+    head = e;
+
+    _count++;
+    _bytes += size;
+    _entry = e;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char*
+PooledString::c_str() const
+{
+    return _entry ? _entry->data : "";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+PooledString::clear()
+{
+    release();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PooledString::empty() const
+{
+    return !_entry;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+string::size_type
+PooledString::find( const string& s, string::size_type pos ) const
+{
+    return str().find( s, pos );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t
+PooledString::heapBytes() const
+{
+    return _entry ? offsetof( Entry, data ) + _entry->length + 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+PooledString::hash( const char* s, size_t length )
+{
+    // FNV-1a
+    uint32 h = 2166136261U;
+    for ( const char* const max = s + length; s < max; s++ ) {
+        h ^= uint8( *s );
+        h *= 16777619U;
+    }
+    return h;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+string::size_type
+PooledString::length() const
+{
+    return _entry ? _entry->length : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString::operator string() const
+{
+    return str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString&
+PooledString::operator=( const PooledString& ref )
+{
+    Entry* const e = ref._entry;  // ref may be *this
+    if (e)
+        e->refs++;
+    release();
+    _entry = e;
+    return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString&
+PooledString::operator=( const string& s )
+{
+    assign( s.data(), s.length() );
+    return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString&
+PooledString::operator=( const char* s )
+{
+    assign( s, strlen( s ));
+    return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PooledString::operator==( const PooledString& ref ) const
+{
+    // equal values always share an entry
+    return _entry == ref._entry;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PooledString::operator==( const string& s ) const
+{
+    return s.length() == length() && !memcmp( s.data(), c_str(), s.length() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PooledString::operator==( const char* s ) const
+{
+    return !strcmp( c_str(), s );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PooledString::operator!=( const PooledString& ref ) const
+{
+    return _entry != ref._entry;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PooledString::operator!=( const string& s ) const
+{
+    return !operator==( s );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PooledString::operator!=( const char* s ) const
+{
+    return !operator==( s );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+PooledString::operator<( const PooledString& ref ) const
+{
+    if (_entry == ref._entry)
+        return false;
+
+    return strcmp( c_str(), ref.c_str() ) < 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t
+PooledString::poolBytes()
+{
+    return _bytes + (_buckets ? (_mask + 1) * sizeof(Entry*) : 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t
+PooledString::poolCount()
+{
+    return _count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+PooledString::rehash( uint32 num )
+{
+    Entry** const buckets = new Entry*[ num ];
+    memset( buckets, 0, num * sizeof(Entry*) );
+
+    if (_buckets) {
+        for ( uint32 i = 0; i <= _mask; i++ ) {
+            for ( Entry* e = _buckets[i]; e; ) {
+                Entry* const next = e->next;
+
+                Entry*& head = buckets[ e->hash & (num - 1) ];
+                e->next = head;
+                head = e;
+
+                e = next;
+            }
+        }
+        delete[] _buckets;
+    }
+
+    _buckets = buckets;
+    _mask    = num - 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+PooledString::release()
+{
+    Entry* const e = _entry;
+    if (!e)
+        return;
+
+    _entry = NULL;
+    if (--e->refs)
+        return;
+
+    for ( Entry** link = &_buckets[ e->hash & _mask ]; *link; link = &(*link)->next ) {
+        if (*link == e) {
+            *link = e->next;
+            break;
+        }
+    }
+
+    _count--;
+    _bytes -= offsetof( Entry, data ) + e->length + 1;
+    free( e );
+
+    // Last string gone (eg. static records destroyed at unload); free table.
+    if (!_count) {
+        delete[] _buckets;
+        _buckets = NULL;
+        _mask    = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+string
+PooledString::str() const
+{
+    return _entry ? string( _entry->data, _entry->length ) : string();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PooledString::Entry** PooledString::_buckets = NULL;
+uint32                PooledString::_mask    = 0;
+size_t                PooledString::_count   = 0;
+size_t                PooledString::_bytes   = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+
+ostream&
+operator<<( ostream& out, const PooledString& s )
+{
+    return out.write( s.c_str(), s.length() );
+}
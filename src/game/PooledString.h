@@ -0,0 +1,87 @@
+#ifndef GAME_POOLEDSTRING_H
+#define GAME_POOLEDSTRING_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * PooledString is an immutable string value shared by every PooledString
+ * holding the same characters. The text is stored once in a reference
+ * counted pool entry; the handle itself is a single pointer, NULL when the
+ * string is empty.
+ *
+ * Used for User fields which are usually empty or repeated across many
+ * records: names, greetings, and mute/ban reasons and authorities.
+ *
+ * Reference counts are not atomic. Handles may only be created, assigned
+ * or destroyed on the main thread; other threads may read handles which
+ * the main thread keeps alive (eg. dbWriter snapshots).
+ */
+class PooledString
+{
+private:
+    struct Entry {
+        Entry* next;    // pool hash chain
+        uint32 hash;
+        uint32 refs;
+        uint32 length;
+        char   data[1]; // NUL-terminated, allocated to length
+    };
+
+    Entry* _entry;
+
+    void assign  ( const char*, size_t );
+    void release ( );
+
+    static Entry** _buckets;  // hash chains, allocated while any entry exists
+    static uint32  _mask;     // bucket count - 1
+    static size_t  _count;    // entries
+    static size_t  _bytes;    // heap bytes of entries
+
+    static uint32 hash   ( const char*, size_t );
+    static void   rehash ( uint32 );
+
+public:
+    PooledString();
+    PooledString( const PooledString& );
+    PooledString( const string& );
+    PooledString( const char* );
+    ~PooledString();
+
+    PooledString& operator= ( const PooledString& );
+    PooledString& operator= ( const string& );
+    PooledString& operator= ( const char* );
+
+    bool operator== ( const PooledString& ) const;
+    bool operator== ( const string& ) const;
+    bool operator== ( const char* ) const;
+    bool operator!= ( const PooledString& ) const;
+    bool operator!= ( const string& ) const;
+    bool operator!= ( const char* ) const;
+    bool operator<  ( const PooledString& ) const;  // by characters
+
+    operator string() const;
+
+    void              clear  ( );
+    const char*       c_str  ( ) const;
+    bool              empty  ( ) const;
+    string::size_type find   ( const string&, string::size_type = 0 ) const;
+    string::size_type length ( ) const;
+    string            str    ( ) const;
+
+    size_t heapBytes() const;  // bytes of shared entry, 0 when empty
+
+    /**************************************************************************
+     * Pool totals: distinct strings and the heap bytes they occupy.
+     *
+     */
+    static size_t poolCount ( );
+    static size_t poolBytes ( );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+ostream& operator<<( ostream&, const PooledString& );
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_POOLEDSTRING_H
@@ -0,0 +1,49 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+ThinkTime::changed()
+{
+    entityScheduler.thinkChanged( *this );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ThinkTime&
+ThinkTime::operator=( const ThinkTime& obj )
+{
+    _time = obj._time;
+    changed();
+    return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ThinkTime&
+ThinkTime::operator=( int time )
+{
+    _time = time;
+    changed();
+    return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ThinkTime&
+ThinkTime::operator+=( int delta )
+{
+    _time += delta;
+    changed();
+    return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ThinkTime&
+ThinkTime::operator-=( int delta )
+{
+    _time -= delta;
+    changed();
+    return *this;
+}
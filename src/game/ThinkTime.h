@@ -0,0 +1,32 @@
+#ifndef GAME_THINKTIME_H
+#define GAME_THINKTIME_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * ThinkTime is the type of gentity_t::nextthink. It reads and writes like
+ * the int it replaces, but every write is reported to EntityScheduler so an
+ * entity parked in the timer wheel is woken when its schedule changes.
+ *
+ * Writes to copies outside g_entities (eg: a backup of an entity on the
+ * stack) are ignored by the scheduler.
+ */
+class ThinkTime
+{
+private:
+    int _time;
+
+    void changed();
+
+public:
+    operator int() const { return _time; }
+
+    ThinkTime& operator=  ( const ThinkTime& );
+    ThinkTime& operator=  ( int );
+    ThinkTime& operator+= ( int );
+    ThinkTime& operator-= ( int );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_THINKTIME_H
@@ -0,0 +1,70 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TraceBatch::TraceBatch()
+    : _size( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TraceBatch::~TraceBatch()
+{
+    clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TraceContext&
+TraceBatch::add( const TraceContext& obj )
+{
+    TraceContext* const trx = ::new( _storage + _size * sizeof(TraceContext) ) TraceContext( obj );
+    _list[_size++] = trx;
+    return *trx;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TraceContext&
+TraceBatch::add( gentity_t& source, gentity_t& actor, int mask, const vec3_t start, const vec3_t end )
+{
+    TraceContext* const trx = ::new( _storage + _size * sizeof(TraceContext) ) TraceContext( source, actor, mask, start, end );
+    _list[_size++] = trx;
+    return *trx;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+TraceBatch::clear()
+{
+    for (int i = 0; i < _size; i++)
+        _list[i]->~TraceContext();
+
+    _size = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TraceContext**
+TraceBatch::list()
+{
+    return _list;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int
+TraceBatch::size() const
+{
+    return _size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TraceContext&
+TraceBatch::operator[]( int index )
+{
+    return *_list[index];
+}
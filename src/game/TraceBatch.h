@@ -0,0 +1,46 @@
+#ifndef GAME_TRACEBATCH_H
+#define GAME_TRACEBATCH_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * TraceBatch holds up to MAX trace contexts in fixed storage, so batched
+ * fire (eg: shotgun pellets) builds its contexts without a heap allocation
+ * per ray. Contexts are constructed in place by add() and destroyed by
+ * clear() or when the batch goes out of scope.
+ */
+class TraceBatch
+{
+public:
+    enum { MAX = 32 };
+
+private:
+    union {
+        char   _storage[ MAX * sizeof(TraceContext) ];
+        double _alignDouble;   // align storage for any TraceContext member
+        void*  _alignPointer;
+    };
+
+    TraceContext* _list[ MAX ];
+    int           _size;
+
+    TraceBatch( const TraceBatch& );             // not copyable
+    TraceBatch& operator=( const TraceBatch& );
+
+public:
+    TraceBatch();
+    ~TraceBatch();
+
+    TraceContext& add   ( const TraceContext& );
+    TraceContext& add   ( gentity_t&, gentity_t&, int, const vec3_t, const vec3_t );
+    void          clear ( );
+
+    TraceContext** list ( );  // for AbstractBulletModel::fireWorld
+    int            size ( ) const;
+
+    TraceContext& operator[]( int );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_TRACEBATCH_H
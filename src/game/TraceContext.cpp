@@ -45,7 +45,7 @@ using namespace text;
 ///////////////////////////////////////////////////////////////////////////////
 
 TraceContext::TraceContext( const TraceContext& obj )
-    : debug  ( xcdebug )
+    : _debug ( NULL )
     , time   ( obj.time )
     , source ( obj.source )
     , actor  ( obj.actor )
@@ -53,6 +53,7 @@ TraceContext::TraceContext( const TraceContext& obj )
     , mask   ( obj.mask )
     , start  ( )  // array initialization not permitted by ISO C++
     , end    ( )  // array initialization not permitted by ISO C++
+    , hit    ( false )
     , hitvol ( 0 )
     , water  ( false )
 {
@@ -71,7 +72,7 @@ TraceContext::TraceContext(
     const vec3_t start_,
     const vec3_t end_ )
 
-    : debug  ( xcdebug )
+    : _debug ( NULL )
     , time   ( __timeForContext( source_, actor_ ))
     , source ( source_ )
     , actor  ( actor_ )
@@ -79,6 +80,7 @@ TraceContext::TraceContext(
     , mask   ( mask_ )
     , start  ( )  // array initialization not permitted by ISO C++
     , end    ( )  // array initialization not permitted by ISO C++
+    , hit    ( false )
     , hitvol ( 0 )
     , water  ( false )
 {
@@ -92,6 +94,26 @@ TraceContext::TraceContext(
 
 TraceContext::~TraceContext()
 {
+    delete _debug;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+text::Buffer&
+TraceContext::debug()
+{
+    if (!_debug)
+        _debug = new Buffer( xcdebug );
+
+    return *_debug;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+TraceContext::debugLength() const
+{
+    return _debug ? _debug->length : 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -99,9 +121,10 @@ TraceContext::~TraceContext()
 void
 TraceContext::dump( const string& name, int index )
 {
-    debug << xheader( name );
+    Buffer& out = debug();
+    out << xheader( name );
     if (index > -1)
-        debug << "[" << xheader( index ) << "]";
+        out << "[" << xheader( index ) << "]";
 
     InlineText colA;
 
@@ -109,7 +132,7 @@ TraceContext::dump( const string& name, int index )
     colA.width  = 14;
     colA.suffixOutside = " = ";
 
-    debug << xlindent
+    out << xlindent
         << "\n" << colA( "source"         ) << xvalue ( source.s.number )
         << "\n" << colA( "source.origin"  ) << xvec3  ( source.r.currentOrigin )
         << "\n" << colA( "actor"          ) << xvalue ( actor.s.number )
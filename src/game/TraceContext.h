@@ -13,6 +13,8 @@ private:
 
     void dump( const string&, int );
 
+    text::Buffer* _debug;  // created by first debug() call
+
 public:
     TraceContext( const TraceContext& );
     TraceContext( gentity_t&, gentity_t&, int mask, const vec3_t, const vec3_t );
@@ -20,11 +22,12 @@ public:
 
     bool resultIsPlayer();
 
+    text::Buffer& debug       ( );        // debug text, allocated on first use
+    uint32        debugLength ( ) const;  // 0 until debug() is first used
+
     bool trace       ( const string& = "", int index = -1 );
     bool traceNoEnts ( const string& = "", int index = -1 );
 
-    text::Buffer debug;
-
     const int          time;    // time for trace, useful for antilag
     gentity_t&         source;  // source of trace (eg. weapon or player)
     gentity_t&         actor;   // actor of trace (eg. player acting with an entity-weapon)
@@ -32,6 +35,7 @@ public:
     const int          mask;    // content mask
     const vec3_t       start;   // start point of ray to trace
     const vec3_t       end;     // end point of ray to trace
+    bool               hit;     // result: true if trace scored a hit
     trace_t            data;    // result: standard trace data
     vec3_t             fpos;    // result: final position (hit point or end of ray)
     float              flen;    // result: final length of ray (up to hit point or end of ray)
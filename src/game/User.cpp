@@ -5,7 +5,9 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 User::User( )
-    : guid          ( _guid )
+    : _guidNext     ( NULL )
+    , _indexed      ( 0 )
+    , guid          ( _guid )
     , fakeguid      ( false )
     , timestamp     ( 0 )
     , authLevel     ( 0 )
@@ -24,7 +26,9 @@ User::User( )
 ///////////////////////////////////////////////////////////////////////////////
 
 User::User( bool console )
-    : guid          ( _guid )
+    : _guidNext     ( NULL )
+    , _indexed      ( 0 )
+    , guid          ( _guid )
     , fakeguid      ( false )
     , timestamp     ( 0 )
     , authLevel     ( 0 )
@@ -42,16 +46,19 @@ User::User( bool console )
     if (console) {
         authLevel = Level::NUM_MAX;
 
-        namex = "^1CONSOLE";
-        name = namex;
-        str::etDecolorize( name );
+        string s = "^1CONSOLE";
+        namex = s;
+        str::etDecolorize( s );
+        name = s;
     }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 User::User( const User& user )
-    : guid        ( _guid )
+    : _guidNext   ( NULL )
+    , _indexed    ( 0 )
+    , guid        ( _guid )
     , privGranted ( NULL )
     , privDenied  ( NULL )
 {
@@ -112,85 +119,55 @@ User::canonicalizePrivileges()
 ///////////////////////////////////////////////////////////////////////////////
 
 void
-User::decode( map<string,string>& data )
+User::decode( const DatabaseRecord& rec )
 {
-    stringstream ss;
-    ss << data["timestamp"];
-    ss >> timestamp;
+    timestamp = time_t( rec.toInt( FIELD_TIMESTAMP ));
     if (timestamp < 0)
         timestamp = 0;
 
-    ip = data["ip"];
-    int len = ip.length();
-    if (len < 1 || len > 15)
-        ip = "";
+    // address ban records may hold a range, "a.b.c.d-e.f.g.h"
+    int len = int( rec.length( FIELD_IP ));
+    ip = (len < 1 || len > 31) ? "" : rec.get( FIELD_IP );
 
-    mac = data["mac"];
-    if (mac.length() != 17)
-        mac = "";
+    mac = rec.length( FIELD_MAC ) == 17 ? rec.get( FIELD_MAC ) : "";
 
-    name = data["name"];
-    namex = data["namex"];
+    string sname  = rec.str( FIELD_NAME );
+    string snamex = rec.str( FIELD_NAMEX );
 
-    if (name.length() >= MAX_NETNAME)
-        name.resize( MAX_NETNAME-1 );
-    if (namex.length() >= MAX_NETNAME)
-        name.resize( MAX_NETNAME-1 );
+    if (sname.length() >= MAX_NETNAME)
+        sname.resize( MAX_NETNAME-1 );
+    if (snamex.length() >= MAX_NETNAME)
+        sname.resize( MAX_NETNAME-1 );
 
     // namex has priority
-    if (namex.empty()) 
-        namex = name;
+    if (snamex.empty()) 
+        snamex = sname;
     else 
-        name = namex;
+        sname = snamex;
 
-    str::etDecolorize( name );
+    str::etDecolorize( sname );
+    name  = sname;
+    namex = snamex;
 
-    greetingText = data["greetingtext"];
-    greetingAudio = data["greetingaudio"];
+    greetingText = rec.get( FIELD_GREETINGTEXT );
+    greetingAudio = rec.get( FIELD_GREETINGAUDIO );
 
-    ss.str("");
-    ss.clear();
-    ss << data["authlevel"];
-    ss >> authLevel;
+    authLevel = int( rec.toInt( FIELD_AUTHLEVEL ));
 
     if (authLevel < 0)
         authLevel = 0;
     else if (authLevel > Level::NUM_MAX)
         authLevel = 0;
 
-    // decode privileges
-    {
-        if (privGranted)
-            privGranted->clear();
-        else
-            privGranted = new PrivilegeSet;
-
-        if (privDenied)
-            privDenied->clear();
-        else
-            privDenied = new PrivilegeSet;
-
-        // MIKE TODO: for 2.1.7 release we can remove concat'd PRIVILEGES 
-        PrivilegeSet::decode( *privGranted, *privDenied, data["acl"] + data["privileges"], data["authflags"] );
-
-        if (privGranted->_handleSet.empty()) {
-            delete privGranted;
-            privGranted = NULL;
-        }
-
-        if (privDenied->_handleSet.empty()) {
-            delete privDenied;
-            privDenied = NULL;
-        }
-    }
+    // MIKE TODO: for 2.1.7 release we can remove concat'd PRIVILEGES 
+    decodePrivileges( rec.str( FIELD_ACL ) + rec.str( FIELD_PRIVILEGES ), rec.str( FIELD_AUTHFLAGS ));
 
-    string& enc = data["xpskills"];
-    if ( enc.length() ) {
+    if (rec.length( FIELD_XPSKILLS )) {
         unsigned long crc = base64::crc32( guid.c_str(), guid.length() );
         char buf[ sizeof(xpSkills) + sizeof(crc) + 1]; // for some reason base64_decode requires +1
 
         // size must match exactly in order to continue XP decoding
-        int nbytes = base64::decode( (const unsigned char*)enc.c_str(), (unsigned char*)buf, sizeof(buf) );
+        int nbytes = base64::decode( (const unsigned char*)rec.get( FIELD_XPSKILLS ), (unsigned char*)buf, sizeof(buf) );
         if ( nbytes == sizeof(buf)-1 ) {
             scramble( buf, sizeof(buf)-1 );
 
@@ -200,106 +177,105 @@ User::decode( map<string,string>& data )
         }
     }
 
-    ss.str("");
-    ss.clear();
-    ss << data["muted"];
-    ss >> muted;
+    muted = rec.toInt( FIELD_MUTED ) != 0;
 
     if (muted) {
-        ss.str("");
-        ss.clear();
-        ss << data["mutetime"];
-        ss >> muteTime;
+        muteTime = time_t( rec.toInt( FIELD_MUTETIME ));
         if (muteTime < 0)
             muteTime = 0;
 
-        ss.str("");
-        ss.clear();
-        ss << data["muteexpiry"];
-        ss >> muteExpiry;
+        muteExpiry = time_t( rec.toInt( FIELD_MUTEEXPIRY ));
         if (muteExpiry < 0)
             muteExpiry = 0;
 
-        muteReason = data["mutereason"];
+        muteReason = rec.get( FIELD_MUTEREASON );
 
-        muteAuthority = data["muteauthority"];
-        muteAuthorityx = data["muteauthorityx"];
+        string auth  = rec.str( FIELD_MUTEAUTHORITY );
+        string authx = rec.str( FIELD_MUTEAUTHORITYX );
 
-        if (muteAuthority.length() >= MAX_NETNAME)
-            muteAuthority.resize( MAX_NETNAME-1 );
-        if (muteAuthorityx.length() >= MAX_NETNAME)
-            muteAuthorityx.resize( MAX_NETNAME-1 );
+        if (auth.length() >= MAX_NETNAME)
+            auth.resize( MAX_NETNAME-1 );
+        if (authx.length() >= MAX_NETNAME)
+            authx.resize( MAX_NETNAME-1 );
 
-        if (muteAuthorityx.empty())
-            muteAuthorityx = muteAuthority;
+        if (authx.empty())
+            authx = auth;
         else
-            muteAuthority = muteAuthorityx;
+            auth = authx;
 
-        str::etDecolorize( muteAuthority );
+        str::etDecolorize( auth );
+        muteAuthority  = auth;
+        muteAuthorityx = authx;
     }
 
-    ss.str("");
-    ss.clear();
-    ss << data["banned"];
-    ss >> banned;
+    banned = rec.toInt( FIELD_BANNED ) != 0;
 
     if (banned) {
-        ss.str("");
-        ss.clear();
-        ss << data["bantime"];
-        ss >> banTime;
+        banTime = time_t( rec.toInt( FIELD_BANTIME ));
         if (banTime < 0)
             banTime = 0;
 
-        ss.str("");
-        ss.clear();
-        ss << data["banexpiry"];
-        ss >> banExpiry;
+        banExpiry = time_t( rec.toInt( FIELD_BANEXPIRY ));
         if (banExpiry < 0)
             banExpiry = 0;
 
-        banReason = data["banreason"];
+        banReason = rec.get( FIELD_BANREASON );
 
-        banAuthority = data["banauthority"];
-        banAuthorityx = data["banauthorityx"];
+        string auth  = rec.str( FIELD_BANAUTHORITY );
+        string authx = rec.str( FIELD_BANAUTHORITYX );
 
-        if (banAuthority.length() >= MAX_NETNAME)
-            banAuthority.resize( MAX_NETNAME-1 );
-        if (banAuthorityx.length() >= MAX_NETNAME)
-            banAuthorityx.resize( MAX_NETNAME-1 );
+        if (auth.length() >= MAX_NETNAME)
+            auth.resize( MAX_NETNAME-1 );
+        if (authx.length() >= MAX_NETNAME)
+            authx.resize( MAX_NETNAME-1 );
 
-        if (banAuthorityx.empty())
-            banAuthorityx = banAuthority;
+        if (authx.empty())
+            authx = auth;
         else
-            banAuthority = banAuthorityx;
+            auth = authx;
 
-        str::etDecolorize( banAuthority );
+        str::etDecolorize( auth );
+        banAuthority  = auth;
+        banAuthorityx = authx;
 
         // automatic expiry
         if (banExpiry && banExpiry <= time( NULL ))
             banned = false;
     }
 
-    vector<string>::size_type vss = 0;
+    const int64 count = rec.toInt( FIELD_NOTES );
+    const vector<string>::size_type vss = count < 0 ? 0 : count > int64( notesMax ) ? notesMax : vector<string>::size_type( count );
 
-    ss.str("");
-    ss.clear();
-    ss << data["notes"];
-    ss >> vss;
+    notes.resize( vss );
+    for (vector<string>::size_type i = 0; i < vss; i++)
+        notes[i] = rec.get( FIELD_NOTE + int(i) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+User::decodePrivileges( const string& acl, const string& authflags )
+{
+    if (privGranted)
+        privGranted->clear();
+    else
+        privGranted = new PrivilegeSet;
 
-    if (vss > notesMax)
-        vss = notesMax;
+    if (privDenied)
+        privDenied->clear();
+    else
+        privDenied = new PrivilegeSet;
 
-    notes.clear();
-    for (vector<string>::size_type i = 0; i < vss; i++) {
-        ostringstream oss;
-        oss << "note." << (int)(i+1);
+    PrivilegeSet::decode( *privGranted, *privDenied, acl, authflags );
 
-        ss.str("");
-        ss.clear();
-        ss << data[ oss.str() ];
+    if (privGranted->_handleSet.empty()) {
+        delete privGranted;
+        privGranted = NULL;
+    }
 
-        notes.push_back( ss.str() );
+    if (privDenied->_handleSet.empty()) {
+        delete privDenied;
+        privDenied = NULL;
     }
 }
 
@@ -334,7 +310,8 @@ User::encode( ostream& out, int recnum )
 
     char ftbuf[32];
     char ftbuf2[32];
-    strftime( ftbuf, sizeof(ftbuf), "%c", localtime( &timestamp ));
+    tm ltm;
+    strftime( ftbuf, sizeof(ftbuf), "%c", process.localtime( timestamp, ltm ));
 
     out << '\n' << "timestamp = " << timestamp << " # " << ftbuf;
     out << '\n' << "ip = "        << ip;
@@ -379,11 +356,11 @@ User::encode( ostream& out, int recnum )
     out << '\n' << "xpSkills = " << enc;
 
     if (muted) {
-        strftime( ftbuf,  sizeof(ftbuf),  "%c", localtime( &muteTime ));
+        strftime( ftbuf,  sizeof(ftbuf),  "%c", process.localtime( muteTime, ltm ));
         if (muteExpiry == 0)
             strcpy( ftbuf2, "PERMANENT" );
         else
-            strftime( ftbuf2, sizeof(ftbuf2), "%c", localtime( &muteExpiry ));
+            strftime( ftbuf2, sizeof(ftbuf2), "%c", process.localtime( muteExpiry, ltm ));
 
         out << '\n' << "muted = "          << muted;
         out << '\n' << "muteTime = "       << muteTime       << " # " << ftbuf;
@@ -394,11 +371,11 @@ User::encode( ostream& out, int recnum )
     }
 
     if (banned) {
-        strftime( ftbuf,  sizeof(ftbuf),  "%c", localtime( &banTime ));
+        strftime( ftbuf,  sizeof(ftbuf),  "%c", process.localtime( banTime, ltm ));
         if (banExpiry == 0)
             strcpy( ftbuf2, "PERMANENT" );
         else
-            strftime( ftbuf2, sizeof(ftbuf2), "%c", localtime( &banExpiry ));
+            strftime( ftbuf2, sizeof(ftbuf2), "%c", process.localtime( banExpiry, ltm ));
 
         out << '\n' << "banned = "        << banned;
         out << '\n' << "banTime = "       << banTime       << " # " << ftbuf;
@@ -516,6 +493,7 @@ User::operator!=( const User& user ) const
 User&
 User::operator=( const User& ref )
 {
+    // Table and index positions belong to the record, not its value.
     _guid         = ref._guid;
     fakeguid      = ref.fakeguid;
     timestamp     = ref.timestamp;
@@ -626,3 +604,47 @@ User User::DEFAULT;
 User User::CONSOLE( true );
 
 const vector<string>::size_type User::notesMax = 9;
+
+namespace {
+    const char* const fieldNames[] = {
+        "guid",
+        "deleted",
+        "timestamp",
+        "ip",
+        "mac",
+        "name",
+        "namex",
+        "greetingtext",
+        "greetingaudio",
+        "authlevel",
+        "acl",
+        "privileges",
+        "authflags",
+        "xpskills",
+        "muted",
+        "mutetime",
+        "muteexpiry",
+        "mutereason",
+        "muteauthority",
+        "muteauthorityx",
+        "banned",
+        "bantime",
+        "banexpiry",
+        "banreason",
+        "banauthority",
+        "banauthorityx",
+        "notes",
+        "note.1",  // notesMax of these
+        "note.2",
+        "note.3",
+        "note.4",
+        "note.5",
+        "note.6",
+        "note.7",
+        "note.8",
+        "note.9",
+        NULL,
+    };
+} // namespace anonymous
+
+const DatabaseSchema User::schema( fieldNames );
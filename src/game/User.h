@@ -17,10 +17,33 @@ class UserDB;
  */
 class User {
     friend class UserDB;
+    friend class UserTable;
 
 private:
     string _guid;
-    
+
+    // UserTable hash chain and suffix index position (32-char GUIDs only)
+    GuidKey                     _guidKey;
+    User*                       _guidNext;
+    map<string,User*>::iterator _guidSuffix;
+
+    // UserDB secondary-index positions; valid for each bit set in _indexed
+    int                                     _indexed;
+    multimap<time_t,User*>::iterator        _indexBANTIME;
+    multimap<PackedAddress,User*>::iterator _indexIP;
+    multimap<PackedAddress,User*>::iterator _indexMAC;
+    multimap<PooledString,User*>::iterator  _indexNAME;
+    multimap<time_t,User*>::iterator        _indexTIME;
+    vector<BanTrie::Prefix>                 _indexBANIP;  // prefixes of ip while banned
+
+    // UserDB name-trigram postings; one per distinct trigram of lowercase name
+    struct NameGram {
+        map<uint32,vector<User*> >::iterator list;  // posting list holding user
+        uint32                               slot;  // position in list
+    };
+
+    vector<NameGram> _indexGrams;
+
 public:
     User ( );
     User ( bool );
@@ -49,12 +72,12 @@ public:
     const string&  guid;           // globally unique ID assigned by punkbuster
     bool           fakeguid;       // track locally assigned guids
     time_t         timestamp;      // time of last connect/disconnect
-    string         ip;             // client IPv4 address updated on connect
-    string         mac;            // client MAC address updated on connect
-    string         name;           // client name updated on connect and change
-    string         namex;          // name w/ extended-color-codes
-    string         greetingText;   // broadcast greeting on connect
-    string         greetingAudio;  // audio to play on connect
+    PackedAddress  ip;             // client IPv4 address updated on connect
+    PackedAddress  mac;            // client MAC address updated on connect
+    PooledString   name;           // client name updated on connect and change
+    PooledString   namex;          // name w/ extended-color-codes
+    PooledString   greetingText;   // broadcast greeting on connect
+    PooledString   greetingAudio;  // audio to play on connect
     int            authLevel;      // authorization level
 
     PrivilegeSet* privGranted;  // per-user granted
@@ -69,22 +92,22 @@ public:
      * Mute attributes.
      *
      */
-    bool   muted;           // true when muted, when false mute* fields are ignored
-    time_t muteTime;        // time of mute
-    time_t muteExpiry;      // when mute expires
-    string muteReason;      // reason for mute
-    string muteAuthority;   // name of user who muted this user
-    string muteAuthorityx;  // muteAuthority w/ extended-color-codes
+    bool         muted;           // true when muted, when false mute* fields are ignored
+    time_t       muteTime;        // time of mute
+    time_t       muteExpiry;      // when mute expires
+    PooledString muteReason;      // reason for mute
+    PooledString muteAuthority;   // name of user who muted this user
+    PooledString muteAuthorityx;  // muteAuthority w/ extended-color-codes
 
     /**************************************************************************
      * Ban attributes.
      */
-    bool   banned;         // true when banned, when false ban* fields are ignored
-    time_t banTime;        // time of ban
-    time_t banExpiry;      // time when ban expires, 0 == permanent
-    string banReason;      // reason for ban
-    string banAuthority;   // name of user who banned this user
-    string banAuthorityx;  // banAuthority w/ extended-color-codes
+    bool         banned;         // true when banned, when false ban* fields are ignored
+    time_t       banTime;        // time of ban
+    time_t       banExpiry;      // time when ban expires, 0 == permanent
+    PooledString banReason;      // reason for ban
+    PooledString banAuthority;   // name of user who banned this user
+    PooledString banAuthorityx;  // banAuthority w/ extended-color-codes
 
     /**************************************************************************
      * Note attributes.
@@ -92,8 +115,40 @@ public:
     vector<string> notes;
 
 private:
-    void  decode ( map<string,string>& );
-    void  encode ( ostream&, int );
+    enum Field {
+        FIELD_GUID,
+        FIELD_DELETED,  // journal tombstone
+        FIELD_TIMESTAMP,
+        FIELD_IP,
+        FIELD_MAC,
+        FIELD_NAME,
+        FIELD_NAMEX,
+        FIELD_GREETINGTEXT,
+        FIELD_GREETINGAUDIO,
+        FIELD_AUTHLEVEL,
+        FIELD_ACL,
+        FIELD_PRIVILEGES,
+        FIELD_AUTHFLAGS,
+        FIELD_XPSKILLS,
+        FIELD_MUTED,
+        FIELD_MUTETIME,
+        FIELD_MUTEEXPIRY,
+        FIELD_MUTEREASON,
+        FIELD_MUTEAUTHORITY,
+        FIELD_MUTEAUTHORITYX,
+        FIELD_BANNED,
+        FIELD_BANTIME,
+        FIELD_BANEXPIRY,
+        FIELD_BANREASON,
+        FIELD_BANAUTHORITY,
+        FIELD_BANAUTHORITYX,
+        FIELD_NOTES,
+        FIELD_NOTE,     // note.1 through note.<notesMax> follow
+    };
+
+    void  decode           ( const DatabaseRecord& );
+    void  decodePrivileges ( const string&, const string& );  // acl, legacy authflags
+    void  encode           ( ostream&, int );
 
 public:
     static User BAD;
@@ -104,6 +159,8 @@ public:
 
 private:
     static void scramble( char*, int );
+
+    static const DatabaseSchema schema;  // field names for decode
 };
 
 ///////////////////////////////////////////////////////////////////////////////
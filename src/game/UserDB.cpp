@@ -2,16 +2,326 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * user.bin layout: header, recordCount records, string table. Integers are
+ * native byte order; a file written with another order is rejected. Strings
+ * are stored as offsets into the table, which begins with the empty string
+ * and ends with a NUL. Both structures are multiples of 8 bytes so records
+ * are aligned in place when the file is mapped.
+ */
+
+const char   BINARY_MAGIC[8]  = { 'J', 'A', 'Y', 'U', 'S', 'R', 'D', 'B' };
+const uint32 BINARY_VERSION   = 1;
+const uint32 BINARY_BYTEORDER = 0x01020304;
+
+struct BinaryHeader
+{
+    char   magic[8];
+    uint32 version;
+    uint32 byteOrder;
+    uint32 headerSize;
+    uint32 recordSize;
+    uint32 recordCount;
+    uint32 stringsOffset;     // from beginning of file
+    uint32 stringsSize;
+    int32  defaultAuthLevel;
+    uint32 defaultAcl;
+    uint32 pad;
+};
+
+struct BinaryRecord
+{
+    int64  timestamp;
+    int64  muteTime;
+    int64  muteExpiry;
+    int64  banTime;
+    int64  banExpiry;
+    uint32 guid;
+    uint32 ip;
+    uint32 mac;
+    uint32 name;
+    uint32 namex;
+    uint32 greetingText;
+    uint32 greetingAudio;
+    uint32 acl;
+    uint32 muteReason;
+    uint32 muteAuthority;
+    uint32 muteAuthorityx;
+    uint32 banReason;
+    uint32 banAuthority;
+    uint32 banAuthorityx;
+    uint32 notes;             // first of notesCount consecutive strings
+    int32  authLevel;
+    char   xp[ sizeof(float) * SK_NUM_SKILLS + sizeof(uint32) ];  // scrambled xpSkills, guid CRC-32
+    uint8  muted;
+    uint8  banned;
+    uint8  notesCount;
+    uint8  pad[ 5 ];
+};
+
+typedef char BinaryHeaderSizeCheck [ sizeof(BinaryHeader) % 8 == 0 ? 1 : -1 ];
+typedef char BinaryRecordSizeCheck [ sizeof(BinaryRecord) % 8 == 0 ? 1 : -1 ];
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+binaryAdd( string& table, const string& s )
+{
+    if (s.empty())
+        return 0;
+
+    const uint32 offset = uint32( table.length() );
+    table.append( s.c_str(), s.length() + 1 );
+    return offset;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char*
+binaryString( const char* table, uint32 size, uint32 offset )
+{
+    // table is verified NUL-terminated, so any offset inside it is a string
+    return offset < size ? table + offset : "";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+gramKey( const char* s )
+{
+    return (uint32( uint8( s[0] )) << 16) | (uint32( uint8( s[1] )) << 8) | uint8( s[2] );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+nameContains( const User& user, const string& key )
+{
+    // key is lowercase; compare against name case-insensitively in place
+    const char* const name = user.name.c_str();
+    const string::size_type klen = key.length();
+    const string::size_type nlen = user.name.length();
+    if (klen > nlen)
+        return false;
+
+    const string::size_type max = nlen - klen;
+    for ( string::size_type i = 0; i <= max; i++ ) {
+        string::size_type j = 0;
+        while (j < klen && char( ::tolower( name[i+j] )) == key[j])
+            j++;
+        if (j == klen)
+            return true;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+isConnected( const User& user )
+{
+    for ( int i = 0; i < MAX_CLIENTS; i++ ) {
+        if (connectedUsers[i] == &user)
+            return true;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+seenCompare( const User* a, const User* b )
+{
+    // most recently seen first
+    return a->timestamp > b->timestamp;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct UserDB::Snapshot : public DatabaseWriter::Job
+{
+    bool         binary;
+    bool         compaction;        // journal bookkeeping on finish
+    string       header;            // ASCII only; includes DEFAULT user
+    int          defaultAuthLevel;  // binary only
+    string       defaultAcl;        // binary only
+    vector<User>  records;
+    vector<User*> order;            // records sorted by guid, built by write()
+    string        journal;          // rotated journal made obsolete by this snapshot
+
+    Snapshot( const string& filename, bool binary_, bool compaction_ )
+        : Job              ( filename, "users" )
+        , binary           ( binary_ )
+        , compaction       ( compaction_ )
+        , defaultAuthLevel ( 0 )
+    {
+    }
+
+    static int guidCompare( const void* a, const void* b )
+    {
+        return (*static_cast<User* const*>( a ))->guid.compare( (*static_cast<User* const*>( b ))->guid );
+    }
+
+    int write( ostream& out )
+    {
+        // Hash table order is arbitrary; files stay sorted by guid.
+        order.reserve( records.size() );
+        const vector<User>::iterator max = records.end();
+        for ( vector<User>::iterator it = records.begin(); it != max; it++ )
+            order.push_back( &*it );
+        if (!order.empty())
+            qsort( &order[0], order.size(), sizeof(User*), guidCompare );
+
+        return binary ? writeBinary( out ) : writeAscii( out );
+    }
+
+    int writeAscii( ostream& out )
+    {
+        out << header;
+
+        int recnum = 1;
+        const vector<User*>::iterator max = order.end();
+        for ( vector<User*>::iterator it = order.begin(); it != max; it++ )
+            (*it)->encode( out, recnum++ );
+
+        out << '\n';
+        return recnum - 1;
+    }
+
+    int writeBinary( ostream& out )
+    {
+        string strings( 1, '\0' );
+
+        BinaryRecord blank;
+        memset( &blank, 0, sizeof(blank) );
+        vector<BinaryRecord> table( order.size(), blank );
+
+        const vector<User*>::size_type max = order.size();
+        for ( vector<User*>::size_type i = 0; i < max; i++ ) {
+            const User& user = *order[i];
+            BinaryRecord& rec = table[i];
+
+            rec.timestamp     = user.timestamp;
+            rec.guid          = binaryAdd( strings, user.guid );
+            rec.ip            = binaryAdd( strings, user.ip );
+            rec.mac           = binaryAdd( strings, user.mac );
+            rec.name          = binaryAdd( strings, user.name );
+            rec.namex         = binaryAdd( strings, user.namex );
+            rec.greetingText  = binaryAdd( strings, user.greetingText );
+            rec.greetingAudio = binaryAdd( strings, user.greetingAudio );
+            rec.authLevel     = user.authLevel;
+
+            if (user.privGranted || user.privDenied) {
+                ostringstream acl;
+                PrivilegeSet::encode( user.privGranted, user.privDenied, acl );
+                rec.acl = binaryAdd( strings, acl.str() );
+            }
+
+            const uint32 crc = uint32( base64::crc32( user.guid.c_str(), user.guid.length() ));
+            memcpy( rec.xp, user.xpSkills, sizeof(user.xpSkills) );
+            memcpy( rec.xp + sizeof(user.xpSkills), &crc, sizeof(crc) );
+            User::scramble( rec.xp, sizeof(rec.xp) );
+
+            rec.muted = user.muted;
+            if (user.muted) {
+                rec.muteTime       = user.muteTime;
+                rec.muteExpiry     = user.muteExpiry;
+                rec.muteReason     = binaryAdd( strings, user.muteReason );
+                rec.muteAuthority  = binaryAdd( strings, user.muteAuthority );
+                rec.muteAuthorityx = binaryAdd( strings, user.muteAuthorityx );
+            }
+
+            rec.banned = user.banned;
+            if (user.banned) {
+                rec.banTime       = user.banTime;
+                rec.banExpiry     = user.banExpiry;
+                rec.banReason     = binaryAdd( strings, user.banReason );
+                rec.banAuthority  = binaryAdd( strings, user.banAuthority );
+                rec.banAuthorityx = binaryAdd( strings, user.banAuthorityx );
+            }
+
+            // notes are stored consecutively, empty ones included
+            const vector<string>::size_type count = user.notes.size() < User::notesMax ? user.notes.size() : User::notesMax;
+            rec.notes      = uint32( strings.length() );
+            rec.notesCount = uint8( count );
+            for ( vector<string>::size_type n = 0; n < count; n++ )
+                strings.append( user.notes[n].c_str(), user.notes[n].length() + 1 );
+        }
+
+        BinaryHeader head;
+        memset( &head, 0, sizeof(head) );
+        memcpy( head.magic, BINARY_MAGIC, sizeof(head.magic) );
+        head.version          = BINARY_VERSION;
+        head.byteOrder        = BINARY_BYTEORDER;
+        head.headerSize       = sizeof(BinaryHeader);
+        head.recordSize       = sizeof(BinaryRecord);
+        head.recordCount      = uint32( table.size() );
+        head.stringsOffset    = uint32( sizeof(BinaryHeader) + table.size() * sizeof(BinaryRecord) );
+        head.defaultAuthLevel = defaultAuthLevel;
+        head.defaultAcl       = binaryAdd( strings, defaultAcl );
+        head.stringsSize      = uint32( strings.length() );
+
+        out.write( reinterpret_cast<const char*>( &head ), sizeof(head) );
+        if (!table.empty())
+            out.write( reinterpret_cast<const char*>( &table[0] ), table.size() * sizeof(BinaryRecord) );
+        out.write( strings.data(), strings.length() );
+
+        return int( table.size() );
+    }
+
+    void finish( bool error )
+    {
+        if (!compaction)
+            return;
+
+        userDB._compacting = false;
+
+        // Keep rotated journal for replay and try again on next save.
+        if (error) {
+            userDB._journalCompact = true;
+            return;
+        }
+
+        ::remove( journal.c_str() );
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 UserDB::UserDB()
-    : Database      ( "user.db", "guid" )
-    , _maxAnonymous ( 16384 )
-    , mapGUID       ( _mapGUID )
-    , mapBANTIME    ( _mapBANTIME )
-    , mapIP         ( _mapIP )
-    , mapMAC        ( _mapMAC )
-    , mapNAME       ( _mapNAME )
-    , mapTIME       ( _mapTIME )
-    , maxAnonymous  ( _maxAnonymous )
+    : Database         ( "user.db", "guid" )
+    , _maxAnonymous    ( 16384 )
+    , _anonymous       ( 0 )
+    , _purgeNext       ( _mapTIME.end() )
+    , _purgeRuns       ( 0 )
+    , _purgeTotal      ( 0 )
+    , _binaryFilename  ( "user.bin" )
+    , _journalFilename ( "user.journal" )
+    , _journalRotated  ( "user.journal.1" )
+    , _journalRecords  ( 0 )
+    , _journalNext     ( 0 )
+    , _journalCompact  ( false )
+    , _compacting      ( false )
+    , mapGUID          ( _mapGUID )
+    , mapBANTIME       ( _mapBANTIME )
+    , mapIP            ( _mapIP )
+    , mapMAC           ( _mapMAC )
+    , mapNAME          ( _mapNAME )
+    , mapTIME          ( _mapTIME )
+    , maxAnonymous     ( _maxAnonymous )
+    , anonymous        ( _anonymous )
+    , purgeRuns        ( _purgeRuns )
+    , purgeTotal       ( _purgeTotal )
 {
 }
 
@@ -53,15 +363,16 @@ UserDB::checkBan( string guid, string ip, string mac, User*& subject, string& de
 
     // MAC
     if (!mac.empty()) {
-        const mapMAC_t::iterator end = _mapMAC.upper_bound( mac );
-        for ( mapMAC_t::iterator it = _mapMAC.lower_bound( mac ); it != end; it++ ) {
+        const PackedAddress key( mac );
+        const mapMAC_t::iterator end = _mapMAC.upper_bound( key );
+        for ( mapMAC_t::iterator it = _mapMAC.lower_bound( key ); it != end; it++ ) {
             User &user = *it->second;
 
             if (!user.banned)
                 continue;
 
             subject = &user;
-            detail = "MAC " + user.mac;
+            detail = "MAC " + user.mac.str();
 
             if (!user.banExpiry)
                 return BAN_ACTIVE;
@@ -73,17 +384,42 @@ UserDB::checkBan( string guid, string ip, string mac, User*& subject, string& de
         }
     }
 
-    // IP
-    if (!ip.empty()) {
-        const mapIP_t::iterator end = _mapIP.upper_bound( ip );
-        for ( mapIP_t::iterator it = _mapIP.lower_bound( ip ); it != end; it++ ) {
+    // IP; addresses, subnets and ranges all live in the ban trie
+    uint32 address;
+    if (!BanTrie::parseAddress( ip, address )) {
+        const vector<User*>* lists[ BanTrie::MATCH_MAX ];
+        const int num = _banTrie.match( address, lists );
+
+        for ( int i = 0; i < num; i++ ) {
+            const vector<User*>::const_iterator max = lists[i]->end();
+            for ( vector<User*>::const_iterator it = lists[i]->begin(); it != max; it++ ) {
+                User &user = **it;
+
+                subject = &user;
+                detail = "IP " + user.ip.str();
+
+                if (!user.banExpiry)
+                    return BAN_ACTIVE;
+
+                else if (user.banExpiry > now)
+                    return BAN_ACTIVE;
+
+                status = BAN_LIFTED;
+            }
+        }
+    }
+    else if (!ip.empty()) {
+        // not dotted-quad (eg. "localhost"), only exact match can apply
+        const PackedAddress key( ip );
+        const mapIP_t::iterator end = _mapIP.upper_bound( key );
+        for ( mapIP_t::iterator it = _mapIP.lower_bound( key ); it != end; it++ ) {
             User &user = *it->second;
 
             if (!user.banned)
                 continue;
 
             subject = &user;
-            detail = "IP " + user.ip;
+            detail = "IP " + user.ip.str();
 
             if (!user.banExpiry)
                 return BAN_ACTIVE;
@@ -99,6 +435,7 @@ UserDB::checkBan( string guid, string ip, string mac, User*& subject, string& de
         unindex( *subject );
         subject->banned = false;
         index( *subject );
+        journal( *subject );
     }
 
     return status;
@@ -106,6 +443,134 @@ UserDB::checkBan( string guid, string ip, string mac, User*& subject, string& de
 
 ///////////////////////////////////////////////////////////////////////////////
 
+UserDB::Snapshot*
+UserDB::capture( bool binary, bool compaction )
+{
+    const Process::ustime_t begin = process.ustime();
+
+    Snapshot* const snap = new Snapshot( pathname( binary ? _binaryFilename : _filename ), binary, compaction );
+
+    if (binary) {
+        snap->defaultAuthLevel = User::DEFAULT.authLevel;
+
+        if (User::DEFAULT.privGranted || User::DEFAULT.privDenied) {
+            ostringstream acl;
+            PrivilegeSet::encode( User::DEFAULT.privGranted, User::DEFAULT.privDenied, acl );
+            snap->defaultAcl = acl.str();
+        }
+    }
+    else {
+        time_t now = time( 0 );
+        char fnow[32];
+        strftime( fnow, sizeof(fnow), "%c", localtime( &now ));
+
+        // Output header
+        ostringstream header;
+        header
+            << "###############################################################################"
+            << '\n' << "##"
+            << '\n' << "## " << JAYMOD_title << " -- " << _filename
+            << '\n' << "## updated: " << fnow
+            << '\n' << "## records: " << _mapGUID.size() << "  (bans: " << _mapBANTIME.size() << ')'
+            << '\n' << "##"
+            << '\n' << "###############################################################################";
+
+        // Output default user; encode() recognizes DEFAULT by address so it cannot be copied
+        User::DEFAULT.encode( header, 0 );
+        snap->header = header.str();
+    }
+
+    // Capture users
+    snap->records.reserve( _mapGUID.size() );
+    const mapGUID_t::iterator max = _mapGUID.end();
+    for ( mapGUID_t::iterator it = _mapGUID.begin(); it != max; it++ ) {
+        // We don't save fake GUIDs
+        if (it->fakeguid)
+            continue;
+
+        // This exists to clean out unused ban records
+        if (it->banned == false && it->guid.substr(0, 6) == "banloc")
+            continue;
+
+        snap->records.push_back( *it );
+    }
+
+    snap->capture = process.ustime() - begin;
+    return snap;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::compact()
+{
+    // One compaction at a time, journal rotation depends on it; changes are
+    // safe in the journal meanwhile.
+    if (_compacting) {
+        journalFlush();
+        _journalCompact = true;
+        return;
+    }
+
+    // Everything in the journal from here back is covered by this snapshot.
+    journalFlush();
+    journalRotate();
+
+    Snapshot* const snap = capture( cvars::g_dbBinary.ivalue != 0, true );
+    snap->journal = pathname( _journalRotated );
+
+    _journalRecords = 0;
+    _journalCompact = false;
+    _compacting     = true;
+
+    dbWriter.submit( snap );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+UserDB::evict( uint32 scan )
+{
+    /* Walk mapTIME from the least recently seen user, resuming where the
+     * last call stopped, and remove anonymous users until back under max.
+     * A user seen again is re-indexed at the newest end, behind the cursor.
+     */
+    uint32 evicted = 0;
+
+    if (_purgeNext == _mapTIME.end())
+        _purgeNext = _mapTIME.begin();
+
+    for ( ; scan && _anonymous > _maxAnonymous && _purgeNext != _mapTIME.end(); scan-- ) {
+        User& user = *_purgeNext->second;
+        _purgeNext++;
+
+        if (!(user._indexed & INDEX_ANON) || user.authLevel || user.banned)
+            continue;
+
+        // Only connectedUsers may hold a User across frames.
+        if (isConnected( user ))
+            continue;
+
+        remove( user );
+        evicted++;
+    }
+
+    _purgeTotal += evicted;
+    return evicted;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::exportText()
+{
+    // Not a compaction; the journal is still needed on top of whichever file
+    // load picks, and replaying it over this snapshot is harmless.
+    dbWriter.submit( capture( false, false ));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 User&
 UserDB::fetchByID( const string& id, string& err )
 {
@@ -119,21 +584,11 @@ UserDB::fetchByID( const string& id, string& err )
         return User::BAD;
     }
 
-    const string::size_type foundpos = 32 - idlen;
-
     string lid = id;
     str::toLower( lid );
 
-    int count = 0;
     User* found = NULL;
-    const mapGUID_t::iterator max = _mapGUID.end();
-    for ( mapGUID_t::iterator it = _mapGUID.begin(); it != max; it++ ) {
-        User& user = it->second;
-        if (user.guid.rfind( lid ) == foundpos) {
-            found = &user;
-            count++;
-        }
-    }
+    const int count = _mapGUID.findSuffix( lid, found );
 
     if (count == 0) {
         err = "not found";
@@ -161,9 +616,9 @@ UserDB::fetchByKey( const string& guid, string& err, bool create )
     string key = guid;
     str::toLower( key );
 
-    const mapGUID_t::iterator found = _mapGUID.find( key );
-    if (found != _mapGUID.end())
-        return found->second;
+    User* const found = _mapGUID.find( key );
+    if (found)
+        return *found;
 
     if (!create) {
         err = "not found";
@@ -171,7 +626,7 @@ UserDB::fetchByKey( const string& guid, string& err, bool create )
     }
 
     // create
-    User& user = _mapGUID[ key ];
+    User& user = _mapGUID.insert( key );
     user = User::DEFAULT;  // inherit default values
     user._guid = key;      // assign correct key
 
@@ -194,97 +649,399 @@ UserDB::fetchByName( const string& name, list<User*>& users, string& err )
     string key = name;
     str::toLower( key );
 
-    // Loop through looking for matches
-    const mapGUID_t::iterator max = _mapGUID.end();
-    for ( mapGUID_t::iterator it = _mapGUID.begin(); it != max; it++ ) {
-        string s = it->second.name;
-        str::toLower( s );
-        if (s.find( key ) != string::npos)
-            users.push_back( &it->second );
+    if (key.length() < 3) {
+        // No trigram to narrow by, and nearly every name matches anyway.
+        const mapNAME_t::iterator max = _mapNAME.end();
+        for ( mapNAME_t::iterator it = _mapNAME.begin(); it != max; it++ ) {
+            User& user = *it->second;
+            if (nameContains( user, key ))
+                users.push_back( &user );
+        }
+    }
+    else {
+        // Every match contains all of the key's trigrams; the rarest one
+        // yields the fewest candidates to verify.
+        const vector<User*>* candidates = NULL;
+
+        const string::size_type max = key.length() - 2;
+        for ( string::size_type i = 0; i < max; i++ ) {
+            const mapGRAM_t::iterator found = _mapGRAM.find( gramKey( key.c_str() + i ));
+            if (found == _mapGRAM.end())
+                return false;
+
+            if (!candidates || found->second.size() < candidates->size())
+                candidates = &found->second;
+        }
+
+        const vector<User*>::const_iterator cmax = candidates->end();
+        for ( vector<User*>::const_iterator it = candidates->begin(); it != cmax; it++ ) {
+            if (nameContains( **it, key ))
+                users.push_back( *it );
+        }
     }
 
+    users.sort( seenCompare );
     return false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void
-UserDB::index( User& user )
+UserDB::gramErase( User& user )
 {
-    if (user.banned) {
-        bool insert = true;
-
-        const mapBANTIME_t::const_iterator max = _mapBANTIME.upper_bound( user.banTime );
-        for ( mapBANTIME_t::const_iterator it = _mapBANTIME.lower_bound( user.banTime ); it != max; it++ ) {
-            if (*it->second == user) {
-                insert = false;
-                break;
+    const vector<User::NameGram>::iterator max = user._indexGrams.end();
+    for ( vector<User::NameGram>::iterator it = user._indexGrams.begin(); it != max; it++ ) {
+        vector<User*>& list = it->list->second;
+
+        // Move last entry into the vacated slot and tell its owner.
+        User* const moved = list.back();
+        list[it->slot] = moved;
+        list.pop_back();
+
+        if (moved != &user) {
+            const vector<User::NameGram>::iterator mmax = moved->_indexGrams.end();
+            for ( vector<User::NameGram>::iterator mit = moved->_indexGrams.begin(); mit != mmax; mit++ ) {
+                if (mit->list == it->list) {
+                    mit->slot = it->slot;
+                    break;
+                }
             }
         }
 
-        if (insert)
-            _mapBANTIME.insert( mapBANTIME_t::value_type( user.banTime, &user ));
+        if (list.empty())
+            _mapGRAM.erase( it->list );
     }
 
-    if (!user.ip.empty()) {
-        bool insert = true;
+    user._indexGrams.clear();
+}
 
-        const mapIP_t::const_iterator max = _mapIP.upper_bound( user.ip );
-        for ( mapIP_t::const_iterator it = _mapIP.lower_bound( user.ip ); it != max; it++ ) {
-            if (*it->second == user) {
-                insert = false;
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::gramInsert( User& user )
+{
+    if (user.name.length() < 3)
+        return;
+
+    string key = user.name;
+    str::toLower( key );
+
+    const string::size_type max = key.length() - 2;
+    user._indexGrams.reserve( max );
+
+    for ( string::size_type i = 0; i < max; i++ ) {
+        const mapGRAM_t::iterator list = _mapGRAM.insert( mapGRAM_t::value_type( gramKey( key.c_str() + i ), vector<User*>() )).first;
+
+        // Repeated trigrams ("aaaa") are posted once.
+        bool posted = false;
+        const vector<User::NameGram>::iterator gmax = user._indexGrams.end();
+        for ( vector<User::NameGram>::iterator it = user._indexGrams.begin(); it != gmax; it++ ) {
+            if (it->list == list) {
+                posted = true;
                 break;
             }
         }
+        if (posted)
+            continue;
 
-        if (insert)
-            _mapIP.insert( mapIP_t::value_type( user.ip, &user ));
+        User::NameGram gram;
+        gram.list = list;
+        gram.slot = uint32( list->second.size() );
+        user._indexGrams.push_back( gram );
+
+        list->second.push_back( &user );
     }
+}
 
-    if (!user.mac.empty()) {
-        bool insert = true;
+///////////////////////////////////////////////////////////////////////////////
 
-        const mapMAC_t::const_iterator max = _mapMAC.upper_bound( user.mac );
-        for ( mapMAC_t::const_iterator it = _mapMAC.lower_bound( user.mac ); it != max; it++ ) {
-            if (*it->second == user) {
-                insert = false;
-                break;
-            }
+void
+UserDB::importText()
+{
+    loadAscii( true );
+    compact();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::index( User& user )
+{
+    // Fields may have changed since last indexed; replace every entry.
+    unindex( user );
+
+    if (user.banned) {
+        user._indexBANTIME = _mapBANTIME.insert( mapBANTIME_t::value_type( user.banTime, &user ));
+        user._indexed |= INDEX_BANTIME;
+
+        if (!user.ip.empty() && !BanTrie::parse( user.ip, user._indexBANIP )) {
+            const vector<BanTrie::Prefix>::iterator max = user._indexBANIP.end();
+            for ( vector<BanTrie::Prefix>::iterator it = user._indexBANIP.begin(); it != max; it++ )
+                _banTrie.insert( *it, user );
+            user._indexed |= INDEX_BANIP;
         }
+    }
 
-        if (insert)
-            _mapMAC.insert( mapMAC_t::value_type( user.mac, &user ));
+    if (!user.ip.empty()) {
+        user._indexIP = _mapIP.insert( mapIP_t::value_type( user.ip, &user ));
+        user._indexed |= INDEX_IP;
+    }
+
+    if (!user.mac.empty()) {
+        user._indexMAC = _mapMAC.insert( mapMAC_t::value_type( user.mac, &user ));
+        user._indexed |= INDEX_MAC;
     }
 
     if (!user.name.empty()) {
-        bool insert = true;
+        user._indexNAME = _mapNAME.insert( mapNAME_t::value_type( user.name, &user ));
+        user._indexed |= INDEX_NAME;
 
-        const mapNAME_t::const_iterator max = _mapNAME.upper_bound( user.name );
-        for ( mapNAME_t::const_iterator it = _mapNAME.lower_bound( user.name ); it != max; it++ ) {
-            if (*it->second == user) {
-                insert = false;
-                break;
-            }
+        gramInsert( user );
+    }
+
+    user._indexTIME = _mapTIME.insert( mapTIME_t::value_type( user.timestamp, &user ));
+    user._indexed |= INDEX_TIME;
+
+    if (!user.authLevel && !user.banned) {
+        _anonymous++;
+        user._indexed |= INDEX_ANON;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint64
+UserDB::indexBytes() const
+{
+    // red-black tree node: color and 3 links, then the value
+    const uint64 node = 4 * sizeof(void*);
+
+    uint64 bytes = 0;
+    bytes += _mapBANTIME.size() * (node + sizeof(mapBANTIME_t::value_type));
+    bytes += _mapIP.size()      * (node + sizeof(mapIP_t::value_type));
+    bytes += _mapMAC.size()     * (node + sizeof(mapMAC_t::value_type));
+    bytes += _mapNAME.size()    * (node + sizeof(mapNAME_t::value_type));
+    bytes += _mapTIME.size()    * (node + sizeof(mapTIME_t::value_type));
+    bytes += _mapGRAM.size()    * (node + sizeof(mapGRAM_t::value_type));
+
+    const mapGRAM_t::const_iterator gmax = _mapGRAM.end();
+    for ( mapGRAM_t::const_iterator it = _mapGRAM.begin(); it != gmax; it++ )
+        bytes += it->second.capacity() * sizeof(User*);
+
+    // per-record positions in the trigram and ban indexes
+    const mapTIME_t::const_iterator max = _mapTIME.end();
+    for ( mapTIME_t::const_iterator it = _mapTIME.begin(); it != max; it++ ) {
+        const User& user = *it->second;
+        bytes += user._indexGrams.capacity() * sizeof(User::NameGram);
+        bytes += user._indexBANIP.capacity() * sizeof(BanTrie::Prefix);
+    }
+
+    // only nodes holding users; interior branch nodes are not counted
+    bytes += _banTrie.size() * (4 * sizeof(void*) + sizeof(BanTrie::Prefix));
+
+    return bytes;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::journal( const User& user )
+{
+    if (!cvars::g_dbJournal.ivalue)
+        return;
+
+    if (user.isNull() || user.fakeguid)
+        return;
+
+    _journalPending.insert( user.guid );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::journalFlush()
+{
+    if (_journalPending.empty())
+        return;
+
+    /* Records are written as they are now, not as they were when queued, so
+     * a guid queued many times costs one record. A guid no longer present in
+     * the memory-map was removed and is written as a tombstone.
+     */
+    ostringstream out;
+    int recnum = 1;
+
+    const set<string>::iterator max = _journalPending.end();
+    for ( set<string>::iterator it = _journalPending.begin(); it != max; it++ ) {
+        User* const found = _mapGUID.find( *it );
+        if (found) {
+            found->encode( out, recnum++ );
+            continue;
         }
 
-        if (insert)
-            _mapNAME.insert( mapNAME_t::value_type( user.name, &user ));
+        out << '\n'
+            << '\n' << "###############################################################################" << '\n'
+            << '\n' << "guid = " << *it
+            << '\n' << "deleted = 1";
+        recnum++;
     }
 
-    {
-        bool insert = true;
+    out << '\n';
 
-        const mapTIME_t::const_iterator max = _mapTIME.upper_bound( user.timestamp );
-        for ( mapTIME_t::const_iterator it = _mapTIME.lower_bound( user.timestamp ); it != max; it++ ) {
-            if (*it->second == user) {
-                insert = false;
-                break;
+    const string filename = pathname( _journalFilename );
+    FILE* file = fopen( filename.c_str(), "ab" );
+    if (!file) {
+        ostringstream msg;
+        msg << "WARNING: unable to open " << filename << " for append" << endl;
+        trap_Printf( msg.str().c_str() );
+        return;
+    }
+
+    const string data = out.str();
+    bool error = fwrite( data.data(), 1, data.length(), file ) != data.length();
+    error = process.fileSync( file ) || error;
+    fclose( file );
+
+    // Leave records pending on error; a whole copy is written on next flush.
+    if (error) {
+        ostringstream msg;
+        msg << "WARNING: error writing " << filename << endl;
+        trap_Printf( msg.str().c_str() );
+        return;
+    }
+
+    _journalRecords += recnum - 1;
+    _journalPending.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int
+UserDB::journalReplay( const string& file )
+{
+    string filename;
+    if (openFile( file, filename, false )) {
+        close();
+        return 0;
+    }
+
+    logBegin( false, filename );
+
+    int num = 0;
+    DatabaseRecord rec( User::schema );
+    while (!atEnd()) {
+        parseRecord( rec );
+
+        if (!rec.has( User::FIELD_GUID ))
+            continue;
+
+        num++;
+
+        // tombstone
+        if (rec.has( User::FIELD_DELETED )) {
+            string key = rec.str( User::FIELD_GUID );
+            str::toLower( key );
+
+            User* const found = _mapGUID.find( key );
+            if (found) {
+                unindex( *found );
+                _mapGUID.erase( *found );
             }
+            continue;
         }
 
-        if (insert)
-            _mapTIME.insert( mapTIME_t::value_type( user.timestamp, &user ));
+        string err;
+        User& user = fetchByKey( rec.str( User::FIELD_GUID ), err, true );
+        if (user.isNull())
+            continue;
+
+        unindex( user );
+        user.decode( rec );
+        index( user );
     }
+
+    logEnd( num, "journal records" );
+    close();
+
+    return num;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::journalRotate()
+{
+    const string journal = pathname( _journalFilename );
+    const string rotated = pathname( _journalRotated );
+
+    FILE* in = fopen( journal.c_str(), "rb" );
+    if (!in)
+        return;
+
+    // Usual case: previous compaction succeeded and removed rotated journal.
+    FILE* out = fopen( rotated.c_str(), "rb" );
+    if (!out) {
+        fclose( in );
+        if (process.fileReplace( journal, rotated )) {
+            ostringstream msg;
+            msg << "WARNING: unable to rename " << journal << endl;
+            trap_Printf( msg.str().c_str() );
+        }
+        return;
+    }
+    fclose( out );
+
+    // Previous compaction failed; its records are still needed, so append.
+    out = fopen( rotated.c_str(), "ab" );
+    if (!out) {
+        fclose( in );
+        ostringstream msg;
+        msg << "WARNING: unable to open " << rotated << " for append" << endl;
+        trap_Printf( msg.str().c_str() );
+        return;
+    }
+
+    bool error = false;
+    char buffer[ 8192 ];
+    for (size_t len; (len = fread( buffer, 1, sizeof(buffer), in )); ) {
+        if (fwrite( buffer, 1, len, out ) != len) {
+            error = true;
+            break;
+        }
+    }
+    error = ferror( in ) || error;
+    error = process.fileSync( out ) || error;
+    fclose( out );
+    fclose( in );
+
+    if (error) {
+        ostringstream msg;
+        msg << "WARNING: error writing " << rotated << endl;
+        trap_Printf( msg.str().c_str() );
+        return;
+    }
+
+    ::remove( journal.c_str() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::journalRun()
+{
+    if (!cvars::g_dbJournal.ivalue || _journalPending.empty())
+        return;
+
+    if (level.time < _journalNext)
+        return;
+
+    _journalNext = level.time + cvars::g_dbJournal.ivalue * 1000;
+    journalFlush();
+
+    // Compact in the background rather than leave it for game-shutdown.
+    const int threshold = cvars::g_dbJournalCompact.ivalue;
+    if (threshold > 0 && _journalRecords >= threshold && !_compacting)
+        compact();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -293,44 +1050,68 @@ void
 UserDB::load( bool merge )
 {
     if (!merge) {
-        _mapGUID.clear();
         _mapBANTIME.clear();
         _mapIP.clear();
         _mapMAC.clear();
         _mapNAME.clear();
         _mapTIME.clear();
+        _mapGRAM.clear();
+        _banTrie.clear();
+        _mapGUID.clear();
+
+        _anonymous = 0;
+        _purgeNext = _mapTIME.end();
     }
 
+    // Read whichever file was written last; on a tie, the one compaction writes.
+    const time_t textTime   = process.fileTime( pathname( _filename ));
+    const time_t binaryTime = process.fileTime( pathname( _binaryFilename ));
+
+    const bool binary = cvars::g_dbBinary.ivalue ? (binaryTime && binaryTime >= textTime) : binaryTime > textTime;
+    if (!binary || loadBinary( merge ))
+        loadAscii( merge );
+
+    _journalRecords = journalReplay( _journalRotated ) + journalReplay( _journalFilename );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::loadAscii( bool merge )
+{
     string filename;
-    if (open( false, filename ))
+    if (open( filename ))
         return;
 
     logBegin( false, filename );
 
     // parse DEFAULT user information
-    map<string,string> data;
-    parseData( data );
-    User::DEFAULT.decode( data );
+    DatabaseRecord rec( User::schema );
+    parseRecord( rec );
+    User::DEFAULT.decode( rec );
 
     // parse each record
-    while (!_stream.rdstate()) {
-        parseData( data );
+    while (!atEnd()) {
+        parseRecord( rec );
 
-        map<string,string>::const_iterator it = data.find( _key );
-        if (it == data.end())
+        if (!rec.has( User::FIELD_GUID ))
             continue;
 
+        const string key = rec.str( User::FIELD_GUID );
+
         string err;
-        User& user = fetchByKey( it->second, err, true );
+        User& user = fetchByKey( key, err, true );
         if (user.isNull()) {
             ostringstream msg;
-            msg << "WARNING: skipping invalid GUID record: " << it->second << endl;
+            msg << "WARNING: skipping invalid GUID record: " << key << endl;
             trap_Printf( msg.str().c_str() );
-            _mapGUID.erase( it->second );
             continue;
         }
 
-        user.decode( data );
+        if (merge)
+            unindex( user );
+
+        user.decode( rec );
         index(user);
     }
 
@@ -340,6 +1121,131 @@ UserDB::load( bool merge )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool
+UserDB::loadBinary( bool merge )
+{
+    const string filename = pathname( _binaryFilename );
+
+    MappedFile file;
+    if (file.open( filename ))
+        return true;
+
+    // Validate layout before touching any records.
+    const BinaryHeader& head = *reinterpret_cast<const BinaryHeader*>( file.data );
+    const uint64 recordsEnd = file.size < sizeof(BinaryHeader)
+        ? 0
+        : uint64( sizeof(BinaryHeader) ) + uint64( head.recordCount ) * sizeof(BinaryRecord);
+
+    if (file.size < sizeof(BinaryHeader)
+        || memcmp( head.magic, BINARY_MAGIC, sizeof(head.magic) )
+        || head.version    != BINARY_VERSION
+        || head.byteOrder  != BINARY_BYTEORDER
+        || head.headerSize != sizeof(BinaryHeader)
+        || head.recordSize != sizeof(BinaryRecord)
+        || head.stringsOffset != recordsEnd
+        || !head.stringsSize
+        || uint64( head.stringsOffset ) + head.stringsSize != file.size
+        || file.data[ file.size - 1 ] != '\0')
+    {
+        ostringstream msg;
+        msg << "-------" << endl
+            << "------- WARNING: invalid or incompatible " << filename << " ." << endl
+            << "------- Reading " << _filename << " instead." << endl
+            << "-------" << endl;
+        trap_Printf( msg.str().c_str() );
+        return true;
+    }
+
+    logBegin( false, filename );
+
+    const char* const strings = file.data + head.stringsOffset;
+    const uint32      ssize   = head.stringsSize;
+
+    User::DEFAULT.authLevel = head.defaultAuthLevel;
+    User::DEFAULT.decodePrivileges( binaryString( strings, ssize, head.defaultAcl ), "" );
+
+    const time_t now = time( NULL );
+
+    const BinaryRecord* const records = reinterpret_cast<const BinaryRecord*>( file.data + sizeof(BinaryHeader) );
+    for ( uint32 i = 0; i < head.recordCount; i++ ) {
+        const BinaryRecord& rec = records[i];
+
+        string err;
+        User& user = fetchByKey( binaryString( strings, ssize, rec.guid ), err, true );
+        if (user.isNull()) {
+            ostringstream msg;
+            msg << "WARNING: skipping invalid GUID record: " << binaryString( strings, ssize, rec.guid ) << endl;
+            trap_Printf( msg.str().c_str() );
+            continue;
+        }
+
+        if (merge)
+            unindex( user );
+
+        user.timestamp     = time_t( rec.timestamp );
+        user.ip            = binaryString( strings, ssize, rec.ip );
+        user.mac           = binaryString( strings, ssize, rec.mac );
+        user.name          = binaryString( strings, ssize, rec.name );
+        user.namex         = binaryString( strings, ssize, rec.namex );
+        user.greetingText  = binaryString( strings, ssize, rec.greetingText );
+        user.greetingAudio = binaryString( strings, ssize, rec.greetingAudio );
+
+        user.authLevel = rec.authLevel;
+        if (user.authLevel < 0 || user.authLevel > Level::NUM_MAX)
+            user.authLevel = 0;
+
+        user.decodePrivileges( binaryString( strings, ssize, rec.acl ), "" );
+
+        // XP is only accepted for the guid it was saved with
+        char xp[ sizeof(rec.xp) ];
+        memcpy( xp, rec.xp, sizeof(xp) );
+        User::scramble( xp, sizeof(xp) );
+
+        uint32 sig;
+        memcpy( &sig, xp + sizeof(user.xpSkills), sizeof(sig) );
+        if (sig == uint32( base64::crc32( user.guid.c_str(), user.guid.length() )))
+            memcpy( user.xpSkills, xp, sizeof(user.xpSkills) );
+
+        user.muted = rec.muted != 0;
+        if (user.muted) {
+            user.muteTime       = time_t( rec.muteTime );
+            user.muteExpiry     = time_t( rec.muteExpiry );
+            user.muteReason     = binaryString( strings, ssize, rec.muteReason );
+            user.muteAuthority  = binaryString( strings, ssize, rec.muteAuthority );
+            user.muteAuthorityx = binaryString( strings, ssize, rec.muteAuthorityx );
+        }
+
+        user.banned = rec.banned != 0;
+        if (user.banned) {
+            user.banTime       = time_t( rec.banTime );
+            user.banExpiry     = time_t( rec.banExpiry );
+            user.banReason     = binaryString( strings, ssize, rec.banReason );
+            user.banAuthority  = binaryString( strings, ssize, rec.banAuthority );
+            user.banAuthorityx = binaryString( strings, ssize, rec.banAuthorityx );
+
+            // automatic expiry
+            if (user.banExpiry && user.banExpiry <= now)
+                user.banned = false;
+        }
+
+        const vector<string>::size_type count = rec.notesCount < User::notesMax ? rec.notesCount : User::notesMax;
+        user.notes.resize( count );
+        uint32 offset = rec.notes;
+        for ( vector<string>::size_type n = 0; n < count; n++ ) {
+            const char* const note = binaryString( strings, ssize, offset );
+            user.notes[n] = note;
+            offset += uint32( user.notes[n].length() + 1 );
+        }
+
+        index( user );
+    }
+
+    logEnd( _mapGUID.size(), "users" );
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 uint32
 UserDB::migrateAuth( int oldauth, int newauth )
 {
@@ -348,11 +1254,13 @@ UserDB::migrateAuth( int oldauth, int newauth )
     // migrate existing users 
     const mapGUID_t::iterator max = _mapGUID.end();
     for ( mapGUID_t::iterator it = _mapGUID.begin(); it != max; it++ ) {
-        User& user = it->second;
+        User& user = *it;
         if (user.authLevel != oldauth)
             continue;
     
         user.authLevel = newauth;
+        index( user );
+        journal( user );
         numMigrated++; 
     }
 
@@ -364,38 +1272,28 @@ UserDB::migrateAuth( int oldauth, int newauth )
 void
 UserDB::purge()
 {
-    /* NOTE: THIS METHOD IS ONLY SAFE TO CALL AT SDK SHUTDOWN TIME.
-     * Loop through (sorted) mapTIME and purge all anonymous records beyond max.
-     */
-    unsigned int count = 0;
-    unsigned int purged = 0;
-
-    const mapTIME_t::reverse_iterator end = _mapTIME.rend();
-    for ( mapTIME_t::reverse_iterator it = _mapTIME.rbegin(); it != end; it++ ) {
-        User& user = *it->second;
-
-        // Skip non-anon users.
-        if (user.authLevel)
-            continue;
-
-        // Skip banned users.
-        if (user.banned)
-            continue;
+    // Catch up on everything purgeRun has not evicted yet.
+    _purgeNext = _mapTIME.end();
+    const uint32 evicted = evict( uint32( _mapTIME.size() ));
 
-        count++;
-        if (count > _maxAnonymous) {
-            _mapGUID.erase( user.guid );
-            purged++;
-        }
-    }
-
-    if (!purged)
+    if (!evicted)
         return;
 
     ostringstream msg;
-    msg << "ANONYMOUS USERS PURGED: " << purged << endl;
+    msg << "ANONYMOUS USERS PURGED: " << evicted << endl;
     trap_Printf( msg.str().c_str() );
+}
 
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserDB::purgeRun()
+{
+    if (_anonymous <= _maxAnonymous)
+        return;
+
+    if (evict( PURGE_SCAN ))
+        _purgeRuns++;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -403,8 +1301,9 @@ UserDB::purge()
 void
 UserDB::remove( User& obj )
 {
+    journal( obj );
     unindex( obj );
-    _mapGUID.erase( obj._guid );
+    _mapGUID.erase( obj );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -412,50 +1311,16 @@ UserDB::remove( User& obj )
 void
 UserDB::save()
 {
-    // Open file
-    string filename;
-    if ( open( true, filename ) )
+    const int records = _journalRecords + int( _journalPending.size() );
+    if (!cvars::g_dbJournal.ivalue || _journalCompact || records >= cvars::g_dbJournalCompact.ivalue) {
+        compact();
         return;
-
-    logBegin( true, filename );
-
-    time_t now = time( 0 );
-    char fnow[32];
-    strftime( fnow, sizeof(fnow), "%c", localtime( &now ));
-
-    // Output header
-    _stream
-        << "###############################################################################"
-        << '\n' << "##"
-        << '\n' << "## " << JAYMOD_title << " -- " << _filename
-        << '\n' << "## updated: " << fnow
-        << '\n' << "## records: " << _mapGUID.size() << "  (bans: " << _mapBANTIME.size() << ')'
-        << '\n' << "##"
-        << '\n' << "###############################################################################";
-
-    // Output default user
-    int recnum = 0;
-    User::DEFAULT.encode( _stream, recnum++ );
-
-    // Output users
-    const mapGUID_t::iterator max = _mapGUID.end();
-    for ( mapGUID_t::iterator it = _mapGUID.begin(); it != max; it++ ) {
-        // We don't save fake GUIDs
-        if (it->second.fakeguid)
-            continue;
-
-        // This exists to clean out unused ban records
-        if (it->second.banned == false && it->second.guid.substr(0, 6) == "banloc")
-            continue;
-
-        // Write the record
-        it->second.encode( _stream, recnum++ );
     }
 
-    _stream << '\n';
-
-    logEnd( _mapGUID.size(), "users" );
-    close();
+    const string filename = pathname( _journalFilename );
+    logBegin( true, filename );
+    journalFlush();
+    logEnd( _journalRecords, "journal records" );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -463,55 +1328,37 @@ UserDB::save()
 void
 UserDB::unindex( User& user )
 {
-    if (user.banned) {
-        const mapBANTIME_t::iterator max = _mapBANTIME.upper_bound( user.banTime );
-        for ( mapBANTIME_t::iterator it = _mapBANTIME.lower_bound( user.banTime ); it != max; it++ ) {
-            if (*it->second == user) {
-                _mapBANTIME.erase( it );
-                break;
-            }
-        }
+    if (user._indexed & INDEX_BANTIME)
+        _mapBANTIME.erase( user._indexBANTIME );
+
+    if (user._indexed & INDEX_BANIP) {
+        const vector<BanTrie::Prefix>::iterator max = user._indexBANIP.end();
+        for ( vector<BanTrie::Prefix>::iterator it = user._indexBANIP.begin(); it != max; it++ )
+            _banTrie.erase( *it, user );
+        user._indexBANIP.clear();
     }
 
-    if (!user.ip.empty()) {
-        const mapIP_t::iterator max = _mapIP.upper_bound( user.ip );
-        for ( mapIP_t::iterator it = _mapIP.lower_bound( user.ip ); it != max; it++ ) {
-            if (*it->second == user) {
-                _mapIP.erase( it );
-                break;
-            }
-        }
-    }
+    if (user._indexed & INDEX_IP)
+        _mapIP.erase( user._indexIP );
 
-    if (!user.mac.empty()) {
-        const mapMAC_t::iterator max = _mapMAC.upper_bound( user.mac );
-        for ( mapMAC_t::iterator it = _mapMAC.lower_bound( user.mac ); it != max; it++ ) {
-            if (*it->second == user) {
-                _mapMAC.erase( it );
-                break;
-            }
-        }
-    }
+    if (user._indexed & INDEX_MAC)
+        _mapMAC.erase( user._indexMAC );
 
-    if (!user.name.empty()) {
-        const mapNAME_t::iterator max = _mapNAME.upper_bound( user.name );
-        for ( mapNAME_t::iterator it = _mapNAME.lower_bound( user.name ); it != max; it++ ) {
-            if (*it->second == user) {
-                _mapNAME.erase( it );
-                break;
-            }
-        }
+    if (user._indexed & INDEX_NAME) {
+        _mapNAME.erase( user._indexNAME );
+        gramErase( user );
     }
 
-    {
-        const mapTIME_t::iterator max = _mapTIME.upper_bound( user.timestamp );
-        for ( mapTIME_t::iterator it = _mapTIME.lower_bound( user.timestamp ); it != max; it++ ) {
-            if (*it->second == user) {
-                _mapTIME.erase( it );
-                break;
-            }
-        }
+    if (user._indexed & INDEX_TIME) {
+        if (_purgeNext == user._indexTIME)
+            _purgeNext++;
+        _mapTIME.erase( user._indexTIME );
     }
+
+    if (user._indexed & INDEX_ANON)
+        _anonymous--;
+
+    user._indexed = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -521,7 +1368,10 @@ UserDB::xpResetAll()
 {
     const mapGUID_t::iterator end = _mapGUID.end();
     for ( mapGUID_t::iterator it = _mapGUID.begin(); it != end; it++ )
-        it->second.xpReset();
+        it->xpReset();
+
+    // too many records to journal; rewrite user.db instead
+    _journalCompact = true;
 }
 
 
@@ -9,6 +9,10 @@
  *
  * A valid GUID is expected to be 32-characters in length.
  *
+ * Records are found by GUID in a hash table keyed by the GUID packed into
+ * 128 bits (see UserTable). Each record remembers its position in the
+ * secondary indexes, so index() and unindex() never search them.
+ *
  * As clients connect/disconnect the server will maintain a pointer to
  * these users in global table connectedUsers corresponding exactly to
  * client slots.
@@ -18,15 +22,48 @@
  * short-lived on the vmMain call stack, ie: do not setup global pointers to
  * any User instances returned from UserDB.
  *
+ * Modified records are queued with journal() and periodically appended to
+ * a journal file (user.journal) in the same format as user.db. Load replays
+ * the journal on top of user.db; deleted records are written as tombstones.
+ * The full user.db is only rewritten (compacted) when the journal grows
+ * large, on bulk changes, on !dbsave, or when journaling is disabled.
+ *
+ * Compaction is written by dbWriter in the background. The journal at that
+ * moment is set aside as user.journal.1 and removed once the new user.db is
+ * in place; load replays user.journal.1 (if any) before user.journal.
+ *
+ * When g_dbBinary is set compaction writes user.bin instead of user.db; a
+ * fixed-size record table followed by a string table, which load maps into
+ * memory and reads without parsing. Load reads whichever of the two files
+ * is newer. exportText() and importText() convert to and from user.db for
+ * hand editing.
+ *
+ * Names are also indexed by trigram: every 3-character substring of the
+ * lowercase name maps to the users whose names contain it. fetchByName
+ * only verifies the users of the query's rarest trigram.
+ *
+ * Index keys share the record's storage: ip and mac are keyed by
+ * PackedAddress, names by PooledString.
+ *
+ * Banned users are indexed by the IPv4 prefixes their ip covers (see
+ * BanTrie), so a ban record whose ip is a subnet or range bans every
+ * address in it.
+ *
+ * Anonymous users (level 0, not banned) are capped at maxAnonymous. Each
+ * frame purgeRun() evicts the least recently seen of them beyond the cap,
+ * examining a bounded number of records and resuming where it left off.
+ * Connected users are never evicted.
+ *
  */
 class UserDB : public Database {
 public:
-    typedef map<const string,User>       mapGUID_t;
-    typedef multimap<time_t,User*>       mapBANTIME_t;
-    typedef multimap<const string,User*> mapMAC_t;
-    typedef multimap<const string,User*> mapIP_t; 
-    typedef multimap<const string,User*> mapNAME_t;
-    typedef multimap<time_t,User*>       mapTIME_t;
+    typedef UserTable                     mapGUID_t;
+    typedef multimap<time_t,User*>        mapBANTIME_t;
+    typedef multimap<PackedAddress,User*> mapMAC_t;
+    typedef multimap<PackedAddress,User*> mapIP_t;
+    typedef multimap<PooledString,User*>  mapNAME_t;
+    typedef multimap<time_t,User*>        mapTIME_t;
+    typedef map<uint32,vector<User*> >    mapGRAM_t;
 
     enum BanStatus {
         BAN_NONE,
@@ -35,21 +72,71 @@ public:
     };
 
 private:
-    mapGUID_t    _mapGUID;     // primary guid->user memory-map
+    struct Snapshot;  // records captured for dbWriter; see UserDB.cpp
+
+    // Bits of User::_indexed, one per secondary index holding the user.
+    enum {
+        INDEX_BANTIME = 0x01,
+        INDEX_IP      = 0x02,
+        INDEX_MAC     = 0x04,
+        INDEX_NAME    = 0x08,
+        INDEX_TIME    = 0x10,
+        INDEX_BANIP   = 0x20,
+        INDEX_ANON    = 0x40,  // counted in _anonymous
+    };
+
+    enum { PURGE_SCAN = 32 };  // records purgeRun examines per frame
+
+    mapGUID_t    _mapGUID;     // primary guid->user hash table, owns records
     mapBANTIME_t _mapBANTIME;  // mac->user index
     mapIP_t      _mapIP;       // ip->user index
     mapMAC_t     _mapMAC;      // mac->user index
     mapNAME_t    _mapNAME;     // name->user index
     mapTIME_t    _mapTIME;     // timestamp->user index
+    mapGRAM_t    _mapGRAM;     // name trigram->users index, see fetchByName
+    BanTrie      _banTrie;     // banned ip prefix->users index, see checkBan
+
+    void gramInsert ( User& );  // add user to trigram posting lists
+    void gramErase  ( User& );  // remove user from trigram posting lists
+
+    unsigned int        _maxAnonymous;  // max number of users w/ level == 0
+    uint32              _anonymous;     // indexed users w/ level == 0, not banned
+    mapTIME_t::iterator _purgeNext;     // next record eviction examines; end to start over
+    uint32              _purgeRuns;     // frames in which purgeRun evicted users
+    uint32              _purgeTotal;    // anonymous users evicted since startup
+
+    uint32 evict( uint32 );  // evict oldest anonymous users over max, examining at most N records
+
+    const string _binaryFilename;   // filename (basename only) used for binary format
+    const string _journalFilename;  // filename (basename only) used for journal
+    const string _journalRotated;   // journal covered by compaction in progress
+    set<string>  _journalPending;   // guids modified since last journal flush
+    int          _journalRecords;   // records written to journal since last compaction
+    int          _journalNext;      // level.time when next flush is allowed
+    bool         _journalCompact;   // bulk change made, compact on next save
+    bool         _compacting;       // snapshot submitted to dbWriter, not yet finished
 
-    unsigned int _maxAnonymous;  // max number of users w/ level == 0
+    Snapshot* capture    ( bool, bool );  // copy records for dbWriter: binary, compaction
+    void      loadAscii  ( bool );        // read user.db
+    bool      loadBinary ( bool );        // read user.bin, returns true on error
+
+    void journalFlush  ( );                // append pending records to journal
+    int  journalReplay ( const string& );  // apply journal records on top of memory-map
+    void journalRotate ( );                // move journal aside for compaction
 
 public:
     UserDB();
     ~UserDB();
 
-    void load ( bool );  // loads all records from disk
-    void save ();        // saves all records to disk
+    void load    ( bool );  // loads all records from disk
+    void save    ();        // flush journal, compact if needed
+    void compact ();        // saves all records to disk and clears journal
+
+    void exportText ( );  // write user.db regardless of g_dbBinary
+    void importText ( );  // merge user.db into memory-map and compact
+
+    void journal    ( const User& );  // queue record for next journal flush
+    void journalRun ( );              // flush journal when due, called each frame
 
     /*
      * Fetch a user by GUID. If the GUID does not exist, one will be
@@ -71,12 +158,15 @@ public:
     void      remove      ( User& );
     BanStatus checkBan    ( string, string, string, User*&, string& );
 
-    void  index   ( User& );  // add to internal indexes
+    void  index   ( User& );  // add to (or refresh in) internal indexes
     void  unindex ( User& );  // remove from internal indexes
 
+    uint64 indexBytes() const;  // approximate heap bytes of secondary indexes
+
     uint32 migrateAuth( int, int );  // migrate users from one level to another
 
     void  purge       ( );  // purge oldest anonymous users if over max
+    void  purgeRun    ( );  // evict a few oldest anonymous users if over max, called each frame
     void  xpResetAll  ( );  // reset all users XP
 
     const mapGUID_t&    mapGUID;     // primary guid->user memory-map
@@ -87,6 +177,9 @@ public:
     const mapTIME_t&    mapTIME;     // timestamp -> user index
 
     const unsigned int& maxAnonymous;  // max number of users w/ level == 0
+    const uint32&       anonymous;     // users w/ level == 0, not banned
+    const uint32&       purgeRuns;     // frames in which purgeRun evicted users
+    const uint32&       purgeTotal;    // anonymous users evicted since startup
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,332 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+GuidKey::GuidKey()
+    : hi ( 0 )
+    , lo ( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+GuidKey::GuidKey( const string& guid )
+    : hi ( 0 )
+    , lo ( 0 )
+{
+    if (guid.length() == 32) {
+        const char* const s = guid.c_str();
+
+        int i = 0;
+        for ( ; i < 32; i++ ) {
+            const char c = s[i];
+
+            uint64 nibble;
+            if (c >= '0' && c <= '9')
+                nibble = c - '0';
+            else if (c >= 'a' && c <= 'f')
+                nibble = c - 'a' + 10;
+            else
+                break;
+
+            uint64& half = i < 16 ? hi : lo;
+            half = (half << 4) | nibble;
+        }
+
+        if (i == 32)
+            return;
+    }
+
+    // Not hex; two independent FNV-1a 64-bit hashes.
+    hi = 14695981039346656037ULL;
+    lo = 0x9ae16a3b2f90404fULL;
+
+    const string::size_type max = guid.length();
+    for ( string::size_type i = 0; i < max; i++ ) {
+        const uint8 c = uint8( guid[i] );
+        hi = (hi ^ c) * 1099511628211ULL;
+        lo = (lo ^ c) * 1099511628211ULL;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+GuidKey::operator==( const GuidKey& ref ) const
+{
+    return hi == ref.hi && lo == ref.lo;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+GuidKey::operator!=( const GuidKey& ref ) const
+{
+    return hi != ref.hi || lo != ref.lo;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32
+GuidKey::hash() const
+{
+    // GUID bits are already well mixed; fold them.
+    const uint64 x = hi ^ (lo * 0x9e3779b97f4a7c15ULL);
+    return uint32( x ^ (x >> 32) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UserTable::iterator::iterator()
+    : _buckets ( NULL )
+    , _bucket  ( 0 )
+    , _user    ( NULL )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UserTable::iterator::iterator( const vector<User*>& buckets, size_t bucket )
+    : _buckets ( &buckets )
+    , _bucket  ( bucket )
+    , _user    ( NULL )
+{
+    const size_t max = buckets.size();
+    for ( ; _bucket < max; _bucket++ ) {
+        _user = buckets[_bucket];
+        if (_user)
+            break;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+User&
+UserTable::iterator::operator*() const
+{
+    return *_user;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+User*
+UserTable::iterator::operator->() const
+{
+    return _user;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UserTable::iterator&
+UserTable::iterator::operator++()
+{
+    _user = _user->_guidNext;
+    if (_user)
+        return *this;
+
+    const size_t max = _buckets->size();
+    for ( _bucket++; _bucket < max; _bucket++ ) {
+        _user = (*_buckets)[_bucket];
+        if (_user)
+            break;
+    }
+
+    return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UserTable::iterator
+UserTable::iterator::operator++( int )
+{
+    iterator old = *this;
+    operator++();
+    return old;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+UserTable::iterator::operator==( const iterator& ref ) const
+{
+    return _user == ref._user;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+UserTable::iterator::operator!=( const iterator& ref ) const
+{
+    return _user != ref._user;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UserTable::UserTable()
+    : _buckets ( 1024, (User*)NULL )
+    , _size    ( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UserTable::~UserTable()
+{
+    clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UserTable::iterator
+UserTable::begin()
+{
+    return iterator( _buckets, 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserTable::clear()
+{
+    const vector<User*>::iterator max = _buckets.end();
+    for ( vector<User*>::iterator it = _buckets.begin(); it != max; it++ ) {
+        for ( User* user = *it; user; ) {
+            User* const next = user->_guidNext;
+            delete user;
+            user = next;
+        }
+        *it = NULL;
+    }
+
+    _size = 0;
+    _suffixes.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool
+UserTable::empty() const
+{
+    return _size == 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UserTable::iterator
+UserTable::end()
+{
+    return iterator();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserTable::erase( User& user )
+{
+    User** link = &_buckets[ user._guidKey.hash() & (_buckets.size() - 1) ];
+    for ( ; *link; link = &(*link)->_guidNext ) {
+        if (*link != &user)
+            continue;
+
+        *link = user._guidNext;
+        if (user._guid.length() == 32)
+            _suffixes.erase( user._guidSuffix );
+        delete &user;
+        _size--;
+        return;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+User*
+UserTable::find( const string& guid )
+{
+    const GuidKey key( guid );
+
+    User* user = _buckets[ key.hash() & (_buckets.size() - 1) ];
+    for ( ; user; user = user->_guidNext ) {
+        if (user->_guidKey == key && user->_guid == guid)
+            return user;
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int
+UserTable::findSuffix( const string& suffix, User*& found )
+{
+    const string key( suffix.rbegin(), suffix.rend() );
+
+    int count = 0;
+    User* match = NULL;
+
+    const mapSUFFIX_t::iterator max = _suffixes.end();
+    for ( mapSUFFIX_t::iterator it = _suffixes.lower_bound( key ); it != max && count < 2; it++ ) {
+        if (it->first.compare( 0, key.length(), key ))
+            break;
+        match = it->second;
+        count++;
+    }
+
+    if (count == 1)
+        found = match;
+
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+User&
+UserTable::insert( const string& guid )
+{
+    if (_size >= _buckets.size())
+        rehash( _buckets.size() * 2 );
+
+    User* const user = new User;
+    user->_guid    = guid;
+    user->_guidKey = GuidKey( guid );
+
+    User*& head = _buckets[ user->_guidKey.hash() & (_buckets.size() - 1) ];
+    user->_guidNext = head;
+    head = user;
+    _size++;
+
+    if (guid.length() == 32)
+        user->_guidSuffix = _suffixes.insert( mapSUFFIX_t::value_type( string( guid.rbegin(), guid.rend() ), user )).first;
+
+    return *user;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+UserTable::rehash( size_t num )
+{
+    vector<User*> buckets( num, (User*)NULL );
+
+    const vector<User*>::iterator max = _buckets.end();
+    for ( vector<User*>::iterator it = _buckets.begin(); it != max; it++ ) {
+        for ( User* user = *it; user; ) {
+            User* const next = user->_guidNext;
+
+            User*& head = buckets[ user->_guidKey.hash() & (num - 1) ];
+            user->_guidNext = head;
+            head = user;
+
+            user = next;
+        }
+    }
+
+    _buckets.swap( buckets );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t
+UserTable::size() const
+{
+    return _size;
+}
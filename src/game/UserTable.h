@@ -0,0 +1,110 @@
+#ifndef GAME_USERTABLE_H
+#define GAME_USERTABLE_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+class User;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * GuidKey is a GUID packed into 128 bits. A 32-digit hex GUID, as assigned
+ * by punkbuster, packs exactly. Any other string (locally generated fake
+ * and ban GUIDs) is hashed instead, so a matching key is only a candidate
+ * until the GUID string is compared.
+ */
+struct GuidKey
+{
+    uint64 hi;
+    uint64 lo;
+
+    GuidKey();
+    explicit GuidKey( const string& );  // lowercase GUID
+
+    bool operator== ( const GuidKey& ) const;
+    bool operator!= ( const GuidKey& ) const;
+
+    uint32 hash() const;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * UserTable owns every User record in UserDB and finds them by GUID in a
+ * chained hash table. Records are allocated individually, so references
+ * remain valid until the record is erased.
+ *
+ * Iteration order is arbitrary. Erasing invalidates iterators at that
+ * record only; collect records first when erasing many.
+ *
+ * 32-character GUIDs are also kept in a sorted map keyed by the reversed
+ * GUID, so the records ending with a given suffix are adjacent and found
+ * with one lower_bound.
+ */
+class UserTable
+{
+public:
+    class iterator {
+        friend class UserTable;
+
+    private:
+        const vector<User*>* _buckets;
+        size_t               _bucket;
+        User*                _user;
+
+        iterator( const vector<User*>&, size_t );
+
+    public:
+        iterator();
+
+        User& operator*  ( ) const;
+        User* operator-> ( ) const;
+
+        iterator& operator++ ( );
+        iterator  operator++ ( int );
+
+        bool operator== ( const iterator& ) const;
+        bool operator!= ( const iterator& ) const;
+    };
+
+private:
+    typedef map<string,User*> mapSUFFIX_t;
+
+    vector<User*> _buckets;   // chain heads, size is a power of 2
+    size_t        _size;
+    mapSUFFIX_t   _suffixes;  // reversed 32-char GUID -> user
+
+    void rehash( size_t );
+
+public:
+    UserTable();
+    ~UserTable();
+
+    iterator begin ( );
+    iterator end   ( );
+
+    void   clear  ( );
+    bool   empty  ( ) const;
+    size_t size   ( ) const;
+
+    User* find   ( const string& );  // lowercase GUID, NULL if not found
+    User& insert ( const string& );  // lowercase GUID which must not exist
+    void  erase  ( User& );          // deletes record
+
+    /**************************************************************************
+     * Find the user whose 32-character GUID ends with suffix (lowercase).
+     *
+     * Returns the number of matching users, counting no further than 2.
+     * Param found is set only when exactly 1 user matches.
+     *
+     */
+    int findSuffix( const string& suffix, User*& found );
+
+private:
+    UserTable( const UserTable& );             // not copyable
+    UserTable& operator=( const UserTable& );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_USERTABLE_H
@@ -0,0 +1,128 @@
+#include <bgame/impl.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+WorkerPool::WorkerPool()
+    : _platform ( 0 )
+    , _size     ( 0 )
+    , _stop     ( false )
+    , _job      ( 0 )
+    , _data     ( 0 )
+    , _count    ( 0 )
+    , size      ( _size )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::resize( int num )
+{
+    if (num < 0)
+        num = 0;
+    else if (num > WORKERS_MAX)
+        num = WORKERS_MAX;
+
+    if (num == _size)
+        return;
+
+    stop();
+    if (!num)
+        return;
+
+    platformAlloc();
+
+    for (int lane = 1; lane <= num; lane++) {
+        if (!platformSpawn( lane )) {
+            G_Printf( "WARNING: worker pool: unable to start thread %d of %d\n", lane, num );
+            break;
+        }
+        _size = lane;
+    }
+
+    if (!_size)
+        platformFree();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::run( job_t job, void* data, int count )
+{
+    if (!_size || count < 2) {
+        for (int i = 0; i < count; i++)
+            job( data, i );
+        return;
+    }
+
+    _job   = job;
+    _data  = data;
+    _count = count;
+
+    platformFpuSave();
+
+    for (int lane = 1; lane <= _size; lane++)
+        platformWake( lane );
+
+    work( 0 );
+
+    for (int lane = 1; lane <= _size; lane++)
+        platformWaitDone();
+
+    _job  = 0;
+    _data = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::stop()
+{
+    if (!_size)
+        return;
+
+    _stop = true;
+    for (int lane = 1; lane <= _size; lane++)
+        platformWake( lane );
+
+    for (int lane = 1; lane <= _size; lane++)
+        platformJoin( lane );
+    _stop = false;
+
+    platformFree();
+    _size = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::work( int lane )
+{
+    // Fixed striping keeps assignment of jobs to lanes stable frame to frame.
+    const int lanes = _size + 1;
+    for (int i = lane; i < _count; i += lanes)
+        _job( _data, i );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::workerMain( WorkerPool& pool, int lane )
+{
+    for (;;) {
+        pool.platformWaitWake( lane );
+        if (pool._stop)
+            break;
+
+        pool.platformFpuApply();
+        pool.work( lane );
+        pool.platformDone();
+    }
+}
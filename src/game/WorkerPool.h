@@ -0,0 +1,62 @@
+#ifndef GAME_WORKERPOOL_H
+#define GAME_WORKERPOOL_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Fixed set of worker threads which run a batch of independent jobs
+ * alongside the calling thread. run() returns only after every job is done.
+ *
+ * Jobs must be pure in-module computation: no trap_* syscalls, no entity
+ * changes and no module heap use. Anything engine-facing belongs to the
+ * calling thread after run() returns.
+ */
+class WorkerPool
+{
+public:
+    typedef void (*job_t)( void*, int );  // called with (data, index)
+
+    enum { WORKERS_MAX = 16 };
+
+private:
+    struct Platform;  // threads, semaphores and FPU state; see <platform>/WorkerPool.cpp
+
+    Platform* _platform;
+    int       _size;
+    bool      _stop;   // workers exit when woken with this set
+
+    // Current batch. Lane 0 is the calling thread, lanes 1.._size are workers.
+    job_t _job;
+    void* _data;
+    int   _count;
+
+    void stop ( );
+    void work ( int );  // run share of current batch for lane
+
+    // Platform-specific.
+    void platformAlloc    ( );
+    void platformFree     ( );
+    bool platformSpawn    ( int );  // start worker thread for lane
+    void platformJoin     ( int );  // wait for worker thread of lane to exit
+    void platformWake     ( int );  // signal lane that batch (or stop) is ready
+    void platformWaitWake ( int );  // worker side of platformWake()
+    void platformDone     ( );      // worker signals its share is done
+    void platformWaitDone ( );      // wait for one platformDone()
+    void platformFpuSave  ( );      // capture calling thread floating-point state
+    void platformFpuApply ( );      // worker adopts state captured for batch
+
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    void resize ( int );                // set number of worker threads, 0 stops all
+    void run    ( job_t, void*, int );  // run job for each index in [0,count)
+
+    static void workerMain( WorkerPool&, int );  // thread body for lane
+
+    const int& size;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_WORKERPOOL_H
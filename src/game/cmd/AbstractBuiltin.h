@@ -21,14 +21,18 @@ private:
 #include <game/cmd/AdminTest.h>
 #include <game/cmd/Ban.h>
 #include <game/cmd/BanInfo.h>
+#include <game/cmd/BanIP.h>
 #include <game/cmd/BanList.h>
 #include <game/cmd/BanUser.h>
 #include <game/cmd/CancelVote.h>
 #include <game/cmd/Chicken.h>
 #include <game/cmd/CrazyGravity.h>
 #include <game/cmd/CryBaby.h>
+#include <game/cmd/DbExport.h>
+#include <game/cmd/DbImport.h>
 #include <game/cmd/DbLoad.h>
 #include <game/cmd/DbSave.h>
+#include <game/cmd/DbStats.h>
 #include <game/cmd/Disorient.h>
 #include <game/cmd/FTime.h>
 #include <game/cmd/Finger.h>
@@ -56,6 +60,7 @@ private:
 #include <game/cmd/Pants.h>
 #include <game/cmd/PanzerWar.h>
 #include <game/cmd/Pause.h>
+#include <game/cmd/Perf.h>
 #include <game/cmd/Pip.h>
 #include <game/cmd/Pop.h>
 #include <game/cmd/PutTeam.h>
@@ -98,13 +103,17 @@ namespace builtins {
     extern AdminTest    adminTest;
     extern Ban          ban;
     extern BanInfo      banInfo;
+    extern BanIP        banIP;
     extern BanList      banList;
     extern BanUser      banUser;
     extern CancelVote   cancelVote;
     extern CrazyGravity crazygravity;
     extern CryBaby      crybaby;
+    extern DbExport     dbExport;
+    extern DbImport     dbImport;
     extern DbLoad       dbLoad;
     extern DbSave       dbSave;
+    extern DbStats      dbStats;
     extern Disorient    disorient;
     extern FTime        ftime;
     extern Finger       finger;
@@ -132,6 +141,7 @@ namespace builtins {
     extern Pants        pants;
     extern PanzerWar    panzerwar;
     extern Pause        pause;
+    extern Perf         perf;
     extern Pip          pip;
     extern Pop          pop;;
     extern PutTeam      putTeam;
@@ -41,6 +41,7 @@ Ban::doBan( User& user, User& authority, int duration, const string& reason, Buf
     user.banAuthorityx = authority.namex;
 
     userDB.index( user );
+    userDB.journal( user );
 
     if (!client)
         return;
@@ -0,0 +1,151 @@
+#include <bgame/impl.h>
+
+namespace cmd {
+
+///////////////////////////////////////////////////////////////////////////////
+
+BanIP::BanIP()
+    : AbstractBuiltin( "banip" )
+{
+    __usage << xvalue( "!" + _name ) << ' ' << xvalue( "ADDRESS" )
+            << ' ' << _ovalue( "SECONDS" )
+            << ' ' << _ovalue( "REASON" );
+
+    __descr << "Ban an IP address, subnet or range."
+            << " ADDRESS is one of " << xvalue( "a.b.c.d" )
+            << ", " << xvalue( "a.b.c.d/BITS" )
+            << ", " << xvalue( "a.b.*" )
+            << " or " << xvalue( "a.b.c.d-e.f.g.h" ) << '.';
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+BanIP::~BanIP()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+AbstractCommand::PostAction
+BanIP::doExecute( Context& txt )
+{
+    if (txt._args.size() < 2)
+        return PA_USAGE;
+
+    // bail on invalid address
+    const string& address = txt._args[1];
+    vector<BanTrie::Prefix> prefixes;
+    if (BanTrie::parse( address, prefixes )) {
+        txt._ebuf << xvalue( "ADDRESS" ) << " is invalid: " << xvalue( address ) << " .";
+        return PA_ERROR;
+    }
+
+    // refuse to ban own address
+    uint32 own;
+    if (txt._client && !BanTrie::parseAddress( txt._user.ip, own ) && BanTrie::covers( prefixes, own )) {
+        txt._ebuf << "You cannot ban yourself.";
+        return PA_ERROR;
+    }
+
+    // Find online players the ban covers. Refuse outright if any is
+    // protected, as the ban would catch them on their next connect anyway.
+    vector<int> targets;
+    for (int i = 0; i < level.numConnectedClients; i++) {
+        const int slot = level.sortedClients[i];
+
+        uint32 ip;
+        if (BanTrie::parseAddress( connectedUsers[slot]->ip, ip ) || !BanTrie::covers( prefixes, ip ))
+            continue;
+
+        const Client& target = g_clientObjects[slot];
+        if (isBotError( target, txt ))
+            return PA_ERROR;
+
+        if (isHigherLevelError( target, txt ))
+            return PA_ERROR;
+
+        targets.push_back( slot );
+    }
+
+    int banDuration = 0;
+    if (txt._args.size() > 2)
+        banDuration = str::toSeconds( txt._args[2] );
+
+    // compute reason text
+    string banReason;
+    if (txt._args.size() > 3)
+        str::concatArgs( txt._args, banReason, 3 );
+
+    if (banDuration < 1) {
+        if (!txt._user.hasPrivilege( priv::base::banPermanent )) {
+            txt._ebuf << "You must specify a non-permanent ban duration.";
+            return PA_ERROR;
+        }
+
+        banDuration = 0;
+    }
+
+    if (banReason.empty()) {
+        if (!txt._user.hasPrivilege( priv::base::reasonNone )) {
+            txt._ebuf << "You must specify a ban reason.";
+            return PA_ERROR;
+        }
+
+        banReason = "none";
+    }
+
+    // Address bans are records of their own with a locally generated GUID.
+    stringstream guidstream;
+    guidstream << setfill( '0' )
+               << "BANNET"
+               << setw( 10 ) << time( NULL )
+               << hex
+               << setw( 4 ) << rand() % 0xffff
+               << setw( 4 ) << rand() % 0x0fff
+               << setw( 4 ) << rand() % 0x3fff
+               << setw( 4 ) << rand() % 0xffff;
+    string guid = guidstream.str();
+    if (guid.length() > 32)
+        guid.resize( 32 );
+
+    string err;
+    User& user = userDB.fetchByKey( guid, err, true );
+    if (user == User::BAD) {
+        txt._ebuf << "Unable to create ban record: " << err << '.';
+        return PA_ERROR;
+    }
+
+    userDB.unindex( user );
+    user.ip    = address;
+    user.name  = address;
+    user.namex = address;
+    userDB.index( user );
+
+    Buffer buf;
+    buf << _name << ": ";
+    Ban::doBan( user, txt._user, banDuration, banReason, buf );
+    printCpm( txt._client, buf, true );
+
+    // Drop covered players. Not walked via sortedClients, which each
+    // disconnect rebuilds.
+    const vector<int>::size_type max = targets.size();
+    for (vector<int>::size_type i = 0; i < max; i++) {
+        const int slot = targets[i];
+
+        Buffer msg;
+        msg << '\n' << "IP: " << xvalue( connectedUsers[slot]->ip )
+            << '\n'
+            << '\n' << "duration:"
+            << '\n' << xvalue( banDuration ? str::toStringSecondsRemaining( banDuration, true ) : "PERMANENT" )
+            << '\n'
+            << '\n' << "reason:"
+            << '\n' << xvalue( banReason );
+        SEngine::dropClient( slot, msg, "You have been banned." );
+    }
+
+    return PA_NONE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace cmd
@@ -0,0 +1,18 @@
+#ifndef GAME_CMD_BANIP_H
+#define GAME_CMD_BANIP_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+class BanIP : public AbstractBuiltin
+{
+protected:
+    PostAction doExecute( Context& );
+
+public:
+    BanIP();
+    ~BanIP();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_CMD_BANIP_H
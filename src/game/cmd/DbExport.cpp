@@ -0,0 +1,39 @@
+#include <bgame/impl.h>
+
+namespace cmd {
+
+///////////////////////////////////////////////////////////////////////////////
+
+DbExport::DbExport()
+    : AbstractBuiltin( "dbexport" )
+{
+    __usage << xvalue( "!" + _name );
+    __descr << "Write the in-memory user database to user.db in text format for editing.";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DbExport::~DbExport()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+AbstractCommand::PostAction
+DbExport::doExecute( Context& txt )
+{
+    if (txt._args.size() != 1)
+        return PA_USAGE;
+
+    userDB.exportText();
+
+    Buffer buf;
+    buf << "exporting: " << xvalue( int(userDB.mapGUID.size()) ) << " users";
+    printCpm( txt._client, buf, true );
+
+    return PA_NONE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace cmd
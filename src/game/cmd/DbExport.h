@@ -0,0 +1,18 @@
+#ifndef GAME_CMD_DBEXPORT_H
+#define GAME_CMD_DBEXPORT_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+class DbExport : public AbstractBuiltin
+{
+protected:
+    PostAction doExecute( Context& );
+
+public:
+    DbExport();
+    ~DbExport();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_CMD_DBEXPORT_H
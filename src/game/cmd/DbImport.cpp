@@ -0,0 +1,39 @@
+#include <bgame/impl.h>
+
+namespace cmd {
+
+///////////////////////////////////////////////////////////////////////////////
+
+DbImport::DbImport()
+    : AbstractBuiltin( "dbimport" )
+{
+    __usage << xvalue( "!" + _name );
+    __descr << "Read & merge user.db in text format, then save the user database.";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DbImport::~DbImport()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+AbstractCommand::PostAction
+DbImport::doExecute( Context& txt )
+{
+    if (txt._args.size() != 1)
+        return PA_USAGE;
+
+    userDB.importText();
+
+    Buffer buf;
+    buf << "imported: " << xvalue( int(userDB.mapGUID.size()) ) << " users";
+    printCpm( txt._client, buf, true );
+
+    return PA_NONE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace cmd
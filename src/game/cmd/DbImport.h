@@ -0,0 +1,18 @@
+#ifndef GAME_CMD_DBIMPORT_H
+#define GAME_CMD_DBIMPORT_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+class DbImport : public AbstractBuiltin
+{
+protected:
+    PostAction doExecute( Context& );
+
+public:
+    DbImport();
+    ~DbImport();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_CMD_DBIMPORT_H
@@ -26,11 +26,11 @@ DbSave::doExecute( Context& txt )
         return PA_USAGE;
 
     levelDB.save();
-    userDB.save();
+    userDB.compact();
 
     Buffer buf;
-    buf << "saved: " << xvalue( int(levelDB.mapLEVEL.size()) ) << " levels\n"
-        << "saved: " << xvalue( int(userDB.mapGUID.size()) ) << " users\n";
+    buf << "saving: " << xvalue( int(levelDB.mapLEVEL.size()) ) << " levels\n"
+        << "saving: " << xvalue( int(userDB.mapGUID.size()) ) << " users\n";
     printCpm( txt._client, buf, true );
 
     return PA_NONE;
@@ -0,0 +1,208 @@
+#include <bgame/impl.h>
+
+namespace cmd {
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Category {
+    const char*      name;
+    uint32           values;  // non-empty values
+    uint64           chars;   // characters in all values
+    uint64           bytes;   // heap bytes; pooled strings counted once
+    set<const char*> seen;    // pool entries already counted
+
+    Category( const char* name_ )
+        : name   ( name_ )
+        , values ( 0 )
+        , chars  ( 0 )
+        , bytes  ( 0 )
+    {
+    }
+
+    void add( const PooledString& s )
+    {
+        if (s.empty())
+            return;
+
+        values++;
+        chars += s.length();
+        if (seen.insert( s.c_str() ).second)
+            bytes += s.heapBytes();
+    }
+
+    void add( const PackedAddress& address )
+    {
+        if (address.empty())
+            return;
+
+        if (!address.packed()) {
+            add( address.text() );
+            return;
+        }
+
+        values++;
+        chars += address.str().length();
+    }
+
+    void add( const string& s )
+    {
+        if (s.empty())
+            return;
+
+        // approximate; short strings may be stored inline
+        values++;
+        chars += s.length();
+        bytes += s.capacity() + 1;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+DbStats::DbStats()
+    : AbstractBuiltin( "dbstats" )
+{
+    __usage << xvalue( "!" + _name );
+    __descr << "Report memory used by the user database, by field category.";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+DbStats::~DbStats()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+AbstractCommand::PostAction
+DbStats::doExecute( Context& txt )
+{
+    if (txt._args.size() != 1)
+        return PA_USAGE;
+
+    Category guids      ( "guids" );
+    Category names      ( "names" );
+    Category addresses  ( "addresses" );
+    Category greetings  ( "greetings" );
+    Category mutes      ( "mute" );
+    Category bans       ( "ban" );
+    Category notes      ( "notes" );
+    Category privileges ( "privileges" );
+
+    uint32 packed = 0;
+
+    const UserDB::mapTIME_t::const_iterator max = userDB.mapTIME.end();
+    for ( UserDB::mapTIME_t::const_iterator it = userDB.mapTIME.begin(); it != max; it++ ) {
+        const User& user = *it->second;
+
+        guids.add( user.guid );
+
+        names.add( user.name );
+        names.add( user.namex );
+
+        addresses.add( user.ip );
+        addresses.add( user.mac );
+        packed += user.ip.packed() + user.mac.packed();
+
+        greetings.add( user.greetingText );
+        greetings.add( user.greetingAudio );
+
+        mutes.add( user.muteReason );
+        mutes.add( user.muteAuthority );
+        mutes.add( user.muteAuthorityx );
+
+        bans.add( user.banReason );
+        bans.add( user.banAuthority );
+        bans.add( user.banAuthorityx );
+
+        notes.bytes += user.notes.capacity() * sizeof(string);
+        const vector<string>::const_iterator nmax = user.notes.end();
+        for ( vector<string>::const_iterator n = user.notes.begin(); n != nmax; n++ )
+            notes.add( *n );
+
+        if (user.privGranted) {
+            privileges.values++;
+            privileges.bytes += sizeof(PrivilegeSet);
+        }
+        if (user.privDenied) {
+            privileges.values++;
+            privileges.bytes += sizeof(PrivilegeSet);
+        }
+    }
+
+    Category* const categories[] = {
+        &guids, &names, &addresses, &greetings, &mutes, &bans, &notes, &privileges,
+    };
+
+    InlineText cName   = xheader;
+    InlineText cValues = xheader;
+    InlineText cChars  = xheader;
+    InlineText cBytes  = xheader;
+
+    cName.flags |= ios::left;
+
+    cName.width   = 12;
+    cValues.width = 8;
+    cChars.width  = 10;
+    cBytes.width  = 10;
+
+    cValues.prefixOutside = ' ';
+    cChars.prefixOutside  = ' ';
+    cBytes.prefixOutside  = ' ';
+
+    Buffer buf;
+    buf << cName   ( "CATEGORY" )
+        << cValues ( "VALUES" )
+        << cChars  ( "CHARS" )
+        << cBytes  ( "HEAP" );
+
+    cName.color   = xcnone;
+    cValues.color = xcnone;
+    cChars.color  = xcnone;
+    cBytes.color  = xcnone;
+
+    const uint64 users = userDB.mapTIME.size();
+    buf << '\n'
+        << cName   ( "records" )
+        << cValues ( users )
+        << cChars  ( "" )
+        << cBytes  ( users * sizeof(User) );
+
+    const uint64 entries = userDB.mapBANTIME.size() + userDB.mapIP.size() + userDB.mapMAC.size()
+        + userDB.mapNAME.size() + userDB.mapTIME.size();
+    buf << '\n'
+        << cName   ( "indexes" )
+        << cValues ( entries )
+        << cChars  ( "" )
+        << cBytes  ( userDB.indexBytes() );
+
+    for ( size_t i = 0; i < sizeof(categories) / sizeof(categories[0]); i++ ) {
+        const Category& cat = *categories[i];
+        buf << '\n'
+            << cName   ( cat.name )
+            << cValues ( cat.values )
+            << cChars  ( cat.chars )
+            << cBytes  ( cat.bytes );
+    }
+
+    buf << '\n'
+        << '\n' << "packed addresses: " << xvalue( packed ) << " of " << xvalue( addresses.values )
+        << '\n' << "string pool: " << xvalue( uint64( PooledString::poolCount() )) << " strings, "
+        << xvalue( uint64( PooledString::poolBytes() )) << " bytes (shared by names, greetings, mute and ban)"
+        << '\n' << "anonymous: " << xvalue( userDB.anonymous ) << " of " << xvalue( userDB.maxAnonymous )
+        << ", evicted " << xvalue( userDB.purgeTotal ) << " over " << xvalue( userDB.purgeRuns ) << " frames";
+
+    Page::report( txt._client, buf );
+    return PA_NONE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace cmd
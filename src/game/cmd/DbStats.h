@@ -0,0 +1,18 @@
+#ifndef GAME_CMD_DBSTATS_H
+#define GAME_CMD_DBSTATS_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+class DbStats : public AbstractBuiltin
+{
+protected:
+    PostAction doExecute( Context& );
+
+public:
+    DbStats();
+    ~DbStats();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_CMD_DBSTATS_H
@@ -0,0 +1,113 @@
+#include <bgame/impl.h>
+
+namespace cmd {
+
+///////////////////////////////////////////////////////////////////////////////
+
+Perf::Perf()
+    : AbstractBuiltin( "perf" )
+{
+    __usage << xvalue( "!" + _name ) << ' ' << _ovalue( "-reset" );
+    __descr << "Report microseconds per server frame spent in each stage, when "
+            << xvalue( "g_perf" ) << " is set.";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Perf::~Perf()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+AbstractCommand::PostAction
+Perf::doExecute( Context& txt )
+{
+    if (txt._args.size() > 2)
+        return PA_USAGE;
+
+    if (!cvars::g_perf.ivalue) {
+        txt._ebuf << "Frame profiling is disabled; set " << xvalue( "g_perf 1" ) << " to enable it.";
+        return PA_ERROR;
+    }
+
+    if (txt._args.size() == 2) {
+        string s = txt._args[1];
+        str::toLower( s );
+        if (s != "-reset")
+            return PA_USAGE;
+
+        frameProfiler.reset();
+
+        Buffer buf;
+        buf << _name << ": frame profile reset.";
+        printCpm( txt._client, buf, true );
+        return PA_NONE;
+    }
+
+    const uint32 frames = frameProfiler.frames();
+    if (!frames) {
+        txt._ebuf << "No frames profiled yet.";
+        return PA_ERROR;
+    }
+
+    InlineText cName = xheader;
+    InlineText cP50  = xheader;
+    InlineText cP95  = xheader;
+    InlineText cP99  = xheader;
+    InlineText cMax  = xheader;
+
+    cName.flags |= ios::left;
+
+    cName.width = 16;
+    cP50.width  = 8;
+    cP95.width  = 8;
+    cP99.width  = 8;
+    cMax.width  = 8;
+
+    cP50.prefixOutside = ' ';
+    cP95.prefixOutside = ' ';
+    cP99.prefixOutside = ' ';
+    cMax.prefixOutside = ' ';
+
+    Buffer buf;
+    buf << "last " << xvalue( frames ) << " frames, microseconds per frame"
+        << '\n'
+        << '\n' << cName ( "STAGE" )
+        << cP50 ( "P50" )
+        << cP95 ( "P95" )
+        << cP99 ( "P99" )
+        << cMax ( "MAX" );
+
+    cName.color = xcnone;
+    cP50.color  = xcnone;
+    cP95.color  = xcnone;
+    cP99.color  = xcnone;
+    cMax.color  = xcnone;
+
+    for ( int i = 0; i < FrameProfiler::NUM_STAGES; i++ ) {
+        const FrameProfiler::Stage stage = FrameProfiler::Stage( i );
+
+        FrameProfiler::Summary sum;
+        frameProfiler.summarize( stage, sum );
+
+        buf << '\n'
+            << cName ( FrameProfiler::name( stage ))
+            << cP50  ( sum.p50 )
+            << cP95  ( sum.p95 )
+            << cP99  ( sum.p99 )
+            << cMax  ( sum.max );
+    }
+
+    buf << '\n'
+        << '\n' << "entities: " << xvalue( entityScheduler.awake() ) << " awake, "
+        << xvalue( entityScheduler.timed() ) << " waiting to think, "
+        << xvalue( entityScheduler.dormant() ) << " dormant";
+
+    Page::report( txt._client, buf );
+    return PA_NONE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace cmd
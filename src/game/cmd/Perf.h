@@ -0,0 +1,18 @@
+#ifndef GAME_CMD_PERF_H
+#define GAME_CMD_PERF_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Perf : public AbstractBuiltin
+{
+protected:
+    PostAction doExecute( Context& );
+
+public:
+    Perf();
+    ~Perf();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GAME_CMD_PERF_H
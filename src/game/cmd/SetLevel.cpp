@@ -50,6 +50,8 @@ SetLevel::doExecute( Context& txt )
     }
 
     targetUser.authLevel = lev.level;
+    userDB.index( targetUser );
+    userDB.journal( targetUser );
 
     // Report success
     Buffer buf;
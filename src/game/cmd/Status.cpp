@@ -156,9 +156,18 @@ Status::doExecute( Context& txt )
     colB.precision = 2;
 
     buf << "\n" << xheader( "-RATES" )
-        << "\n" << colA("entity spawn") << colB( stats::entitySpawn.avg() )
-        << "\n" << colA("entity free")  << colB( stats::entityFree.avg() )
-        << "\n" << colA("frames")       << colB( stats::frame.avg() );
+        << "\n" << colA("entity spawn")  << colB( stats::entitySpawn.rate() )
+        << "\n" << colA("entity free")   << colB( stats::entityFree.rate() )
+        << "\n" << colA("frames")        << colB( stats::frame.rate() )
+        << "\n" << colA("antilag recon") << colB( stats::antilagReconciled.rate() )
+        << "\n" << colA("antilag skip")  << colB( stats::antilagSkipped.rate() )
+        << "\n" << colA("antilag ghost") << colB( stats::antilagGhosts.rate() );
+
+    // hitmodePose is sampled once per frame, so its mean is the per-frame cost
+    colB.suffix = " usec/frame";
+
+    buf << "\n" << xheader( "-TIMING" )
+        << "\n" << colA("hitmode pose")  << colB( stats::hitmodePose.mean() );
 
     bool broadcast = false;
     if (txt._args.size() > 1) {
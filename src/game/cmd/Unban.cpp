@@ -34,6 +34,7 @@ Unban::doExecute( Context& txt )
     userDB.unindex( user );
     user.banned = false;
     userDB.index( user );
+    userDB.journal( user );
 
     Buffer buf;
     buf << _name << ": User ID " << xvalue( id ) << " (" << xvalue( user.namex ) << ") unbanned.";
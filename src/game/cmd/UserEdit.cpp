@@ -43,6 +43,9 @@ UserEdit::doExecute( Context& txt )
     if (isHigherLevelError( user, txt ))
         return PA_ERROR;
 
+    // journal captures the record at flush time, including edits made below
+    userDB.journal( user );
+
     // parse options
     string shead = "-" + _name;
     str::toUpper( shead );
@@ -61,13 +64,17 @@ UserEdit::doExecute( Context& txt )
         str::toLower( s );
 
         if (s == "-gtext") {
-            str::concatArgs( txt._args, user.greetingText, ++i );
+            string text;
+            str::concatArgs( txt._args, text, ++i );
+            user.greetingText = text;
             buf << "modified greeting text: " << xvalue( user.greetingText );
             break;
         }
 
         if (s == "-gaudio") {
-            str::concatArgs( txt._args, user.greetingAudio, ++i );
+            string audio;
+            str::concatArgs( txt._args, audio, ++i );
+            user.greetingAudio = audio;
             buf << "modified greeting audio: " << xvalue( user.greetingAudio );
             break;
         }
@@ -237,6 +244,7 @@ UserEdit::doExecute( Context& txt )
             }
 
             user.authLevel = lev.level;
+            userDB.index( user );  // anonymous count depends on level
 
             buf << xvalue( user.namex ) << "'s level set to " << xvalue( lev.level );
         }
@@ -65,7 +65,6 @@ UserList::doExecute( Context& txt )
             }
             else if (s == "-name") {
                 filter.name = txt._args[++i];
-                str::toLower( filter.name );
             }
             else if (s == "-since") {
                 filter.since = str::toSeconds( txt._args[++i] );
@@ -114,10 +113,22 @@ UserList::doExecute( Context& txt )
     const time_t now = time( NULL );
     string tmp;
 
+    // name filter comes from the trigram index, most recently seen first
+    list<User*> users;
+    if (filter.name.empty()) {
+        const UserDB::mapNAME_t::const_iterator max = userDB.mapNAME.end();
+        for ( UserDB::mapNAME_t::const_iterator it = userDB.mapNAME.begin(); it != max; it++ )
+            users.push_back( it->second );
+    }
+    else {
+        string err;
+        userDB.fetchByName( filter.name, users, err );
+    }
+
     uint32 num = 0;
-    const UserDB::mapNAME_t::const_iterator max = userDB.mapNAME.end();
-    for ( UserDB::mapNAME_t::const_iterator it = userDB.mapNAME.begin(); it != max; it++ ) {
-        const User& user = *it->second;
+    const list<User*>::const_iterator max = users.end();
+    for ( list<User*>::const_iterator it = users.begin(); it != max; it++ ) {
+        const User& user = **it;
         const string id = (user.guid.length() == 32) ? user.guid.substr( 24 ) : "";
 
         if (!filter.ip.empty() && (user.ip.find( filter.ip ) == string::npos))
@@ -126,13 +137,6 @@ UserList::doExecute( Context& txt )
         if (filter.level != -1 && user.authLevel != filter.level)
             continue;
 
-        if (!filter.name.empty()) {
-            tmp = user.name;
-            str::toLower( tmp );
-            if (tmp.find( filter.name ) == string::npos)
-                continue;
-        }
-
         if (filter.since > 0 && ((now - user.timestamp) > filter.since))
             continue;
 
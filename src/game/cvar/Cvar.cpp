@@ -2,6 +2,45 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+const int POLL_BUDGET = 4;  // variables without CVAR_JAYMODHOT polled per frame
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+void
+Cvar::poll()
+{
+    const list<Cvar*>::iterator end = Cvar::UPDATE.end();
+    for ( list<Cvar*>::iterator it = Cvar::UPDATE.begin(); it != end; it++ ) {
+        if ((*it)->flags & CVAR_JAYMODHOT)
+            (*it)->trapUpdate();
+    }
+
+    if (Cvar::UPDATE.empty())
+        return;
+
+    // Round-robin position survives between frames; UPDATE never changes after init.
+    static list<Cvar*>::iterator next = end;
+
+    for ( int i = 0; i < POLL_BUDGET; i++ ) {
+        if (next == end)
+            next = Cvar::UPDATE.begin();
+
+        Cvar& v = **next++;
+        if (!(v.flags & CVAR_JAYMODHOT))
+            v.trapUpdate();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 Cvar::update()
 {
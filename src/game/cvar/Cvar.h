@@ -11,12 +11,18 @@ namespace objects {
     extern Cvar g_bulletmodeReference;
     extern Cvar g_bulletmodeTrail;
 
+    extern Cvar g_dbBinary;
+    extern Cvar g_dbJournal;
+    extern Cvar g_dbJournalCompact;
+
     extern Cvar g_hitmodeAntilag;
     extern Cvar g_hitmodeAntilagLerp;
     extern Cvar g_hitmodeDebug;
     extern Cvar g_hitmodeFat;
     extern Cvar g_hitmodeGhosting;
+    extern Cvar g_hitmodeLazy;
     extern Cvar g_hitmodeReference;
+    extern Cvar g_hitmodeThreads;
     extern Cvar g_hitmodeZone;
 
     extern Cvar g_kickMessage;
@@ -24,6 +30,7 @@ namespace objects {
     extern Cvar g_protestMessage;
 
     extern Cvar g_maxLandmines;
+    extern Cvar g_perf;
     extern Cvar g_snap;
     extern Cvar g_shutdownExit;
     extern Cvar g_warmup;
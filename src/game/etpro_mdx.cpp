@@ -229,9 +229,39 @@ static char (*cachetag_names)[64] = NULL;
 static int hit_count = 0;
 static hit_t *hits = NULL;
 
-/* Space for calculated bone origins -- new calculations overwrite the previous */
+/* Largest bone count of any loaded mdx */
 static int mdx_bones_max = 0;
-static vec3_t *mdx_bones = NULL;
+
+/*
+ * Pose cache. Bone origins depend only on the frame models, frames and
+ * backlerps of a grefEntity_t, so each slot remembers the pose it last
+ * computed and which of its bones are done. Repeated tag lookups on the same
+ * pose (eg. every tag of a hit-model in one frame) then compute each bone
+ * once. Clients get their own slot; everything else shares slot 0.
+ * There is no "current" slot: callers resolve it from the refent, so
+ * different clients may be posed concurrently from worker threads.
+ */
+typedef struct {
+	const mdx_t *frameModel, *oldFrameModel;
+	const mdx_t *torsoFrameModel, *oldTorsoFrameModel;
+	int frame, oldFrame;
+	int torsoFrame, oldTorsoFrame;
+	float backlerp, torsoBacklerp;
+} mdx_posekey_t;
+
+typedef struct {
+	mdx_posekey_t key;
+	int epoch;			/* mdx_pose_epoch when key was set */
+	int generation;		/* bone is valid when stamps[i] == generation */
+	int bone_max;
+	vec3_t *bones;
+	int *stamps;
+} mdx_pose_t;
+
+#define MDX_POSE_SLOTS	(MAX_CLIENTS + 1)
+
+static mdx_pose_t mdx_poses[MDX_POSE_SLOTS];
+static int mdx_pose_epoch = 0;	/* bumped whenever model data changes */
 
 #define INDEXTOQHANDLE(idx)		(qhandle_t)((idx)+1)
 // Index may be NULL sometimes, so just default to the first model (FIXME: This is a HACK.)
@@ -245,8 +275,13 @@ void mdx_cleanup(void)
 	int i;
 
 	mdx_bones_max = 0;
-	free(mdx_bones);
-	mdx_bones = NULL;
+
+	for (i = 0; i < MDX_POSE_SLOTS; i++) {
+		free(mdx_poses[i].bones);
+		free(mdx_poses[i].stamps);
+	}
+	memset(mdx_poses, 0, sizeof(mdx_poses));
+	mdx_pose_epoch++;
 
 #ifdef BONE_HITTESTS
 	cachetag_count = 0;
@@ -317,8 +352,10 @@ static void MatrixWeight(/*const*/ vec3_t m[3], float weight, vec3_t mout[3])
 	mout[2][2] = m[2][2]*weight + one;
 }
 
+#ifdef DEBUG
 /* The engine transforms short angles to an axis somewhat brokenly -
-   it uses a LUT and has truely perplexing values */
+   it uses a LUT and has truely perplexing values.
+   Only kept to cross-check AnglesToForwardBroken. */
 static void AnglesToAxisBroken(const short angles[2], vec3_t matrix[3])
 {
 	int idx;
@@ -346,6 +383,28 @@ static void AnglesToAxisBroken(const short angles[2], vec3_t matrix[3])
 	matrix[2][1] = sp*sy;
 	matrix[2][2] = cp;
 }
+#endif /* DEBUG */
+
+/* First row of AnglesToAxisBroken only; same values, a third of the work */
+static void AnglesToForwardBroken(const short angles[2], vec3_t forward)
+{
+	int idx;
+	float sp, sy, cp, cy;
+
+	idx = angles[0]>>4;
+	if (idx < 0) idx += 4096;
+	sp = sintable[idx];
+	cp = sintable[(idx + 1024) % 4096];
+
+	idx = angles[1]>>4;
+	if (idx < 0) idx += 4096;
+	sy = sintable[idx];
+	cy = sintable[(idx + 1024) % 4096];
+
+	forward[0] = cp*cy;
+	forward[1] = cp*sy;
+	forward[2] = -sp;
+}
 
 #ifdef BONE_HITTESTS
 static void mdx_matrix_to_quaternion(vec3_t m[3], vec4_t q)
@@ -424,6 +483,7 @@ void mdx_gentity_to_grefEntity(gentity_t *ent, grefEntity_t *refent, int lerpTim
 	}
 
 	refent->hModel = character->mesh;
+	refent->poseSlot = (ent->s.number < MAX_CLIENTS) ? ent->s.number + 1 : 0;
 	VectorCopy(ent->r.currentOrigin, refent->origin);
 
 	refent->frame = ent->legsFrame.frame;
@@ -582,11 +642,9 @@ static void mdx_load(mdx_t *mdxModel, char *mem)
 
 	mdxModel->torso_parent = mdx_read_int(hdr->torso_parent);
 
-	if (bone_count > mdx_bones_max) {
-		free(mdx_bones);
+	if (bone_count > mdx_bones_max)
 		mdx_bones_max = bone_count;
-		mdx_bones = (vec3_t*)malloc(mdx_bones_max * sizeof(*mdx_bones));
-	}
+	mdx_pose_epoch++;
 
 	/* Load bones */
 	mdxModel->bone_count = bone_count;
@@ -1117,23 +1175,151 @@ qhandle_t mdx_RegisterHits(animModelInfo_t *animModelInfo, const char *filename)
 /**************************************************************/
 /* Bone Calculations */
 
+#ifdef DEBUG
+#define MDX_BONE_EPSILON	0.001f	/* model units */
+
+/* Set by mdx_calculate_bone, which may run on a worker; see mdx_pose_verify() */
+static volatile int mdx_bone_mismatch = 0;
+#endif
+
 static void mdx_calculate_bone(
 	vec3_t dest,
 	const struct bone *bone,
 	const struct frame_bone *frameBone
 ) {
-	vec3_t tmp;
-	vec3_t axis[3];
+	vec3_t forward;
+
+	/* frame bone rotation; (parent_dist, 0, 0) only picks up the forward axis */
+	AnglesToForwardBroken(frameBone->offset_angles, forward);
+	dest[0] = bone->parent_dist*forward[0];
+	dest[1] = bone->parent_dist*forward[1];
+	dest[2] = bone->parent_dist*forward[2];
+
+#ifdef DEBUG
+	{
+		vec3_t tmp, check;
+		vec3_t axis[3];
+
+		tmp[1] = tmp[2] = 0;
+		tmp[0] = bone->parent_dist;
+
+		AnglesToAxisBroken(frameBone->offset_angles, axis);
+		PointRotate(tmp, axis, check);
+
+		/* x87 may keep either path in extended precision, so allow rounding */
+		if (fabs(dest[0] - check[0]) > MDX_BONE_EPSILON
+		 || fabs(dest[1] - check[1]) > MDX_BONE_EPSILON
+		 || fabs(dest[2] - check[2]) > MDX_BONE_EPSILON) {
+			mdx_bone_mismatch = 1;
+		}
+	}
+#endif
+}
+
+/* Grows the bone buffers of pose to fit the largest loaded mdx */
+static void mdx_pose_grow(mdx_pose_t *pose)
+{
+	if (pose->bone_max >= mdx_bones_max)
+		return;
+
+	free(pose->bones);
+	free(pose->stamps);
+	pose->bone_max = mdx_bones_max;
+	pose->bones = (vec3_t*)malloc(pose->bone_max * sizeof(*pose->bones));
+	pose->stamps = (int*)malloc(pose->bone_max * sizeof(*pose->stamps));
+	memset(pose->stamps, 0, pose->bone_max * sizeof(*pose->stamps));
+	pose->generation++;
+}
+
+/*
+ * Sizes every pose slot for the largest loaded mdx, so mdx_pose_select()
+ * never allocates. Must be called on the main thread before posing on
+ * worker threads; mdx_bones_max only changes while models are loaded.
+ */
+void mdx_pose_reserve(void)
+{
+	int i;
+
+	for (i = 0; i < MDX_POSE_SLOTS; i++)
+		mdx_pose_grow(&mdx_poses[i]);
+}
+
+/*
+ * Reports a mismatch found by the DEBUG bone rotation cross-check.
+ * Worker threads must not G_Error, so mdx_calculate_bone only flags it;
+ * call on the main thread once posing is done.
+ */
+void mdx_pose_verify(void)
+{
+#ifdef DEBUG
+	if (mdx_bone_mismatch) {
+		mdx_bone_mismatch = 0;
+		G_Error(GAME_VERSION " MDX: Bone rotation mismatch\n");
+	}
+#endif
+}
 
-	tmp[1] = tmp[2] = 0;
-	tmp[0] = bone->parent_dist;
+/* Returns the pose cache slot for refent */
+static mdx_pose_t *mdx_pose_slot(const grefEntity_t *refent)
+{
+	int slot;
 
-	/* frame bone rotation */
-	AnglesToAxisBroken(frameBone->offset_angles, axis);
-	PointRotate(tmp, axis, dest);
+	slot = refent->poseSlot;
+	if (slot < 0 || slot >= MDX_POSE_SLOTS)
+		slot = 0;
+	return &mdx_poses[slot];
+}
+
+/* Selects the pose cache slot for refent, invalidating it if the pose changed */
+static mdx_pose_t *mdx_pose_select(
+	/*const*/ grefEntity_t *refent,
+	const mdx_t *frameModel,
+	const mdx_t *oldFrameModel,
+	const mdx_t *torsoFrameModel,
+	const mdx_t *oldTorsoFrameModel
+)
+{
+	mdx_posekey_t key;
+	mdx_pose_t *pose;
+
+	pose = mdx_pose_slot(refent);
+	mdx_pose_grow(pose);	/* no-op after mdx_pose_reserve() */
+
+	memset(&key, 0, sizeof(key));
+	key.frameModel = frameModel;
+	key.oldFrameModel = oldFrameModel;
+	key.torsoFrameModel = torsoFrameModel;
+	key.oldTorsoFrameModel = oldTorsoFrameModel;
+	key.frame = refent->frame;
+	key.oldFrame = refent->oldframe;
+	key.torsoFrame = refent->torsoFrame;
+	key.oldTorsoFrame = refent->oldTorsoFrame;
+	key.backlerp = refent->backlerp;
+	key.torsoBacklerp = refent->torsoBacklerp;
+
+	if (pose->epoch == mdx_pose_epoch
+	 && key.frameModel == pose->key.frameModel
+	 && key.oldFrameModel == pose->key.oldFrameModel
+	 && key.torsoFrameModel == pose->key.torsoFrameModel
+	 && key.oldTorsoFrameModel == pose->key.oldTorsoFrameModel
+	 && key.frame == pose->key.frame
+	 && key.oldFrame == pose->key.oldFrame
+	 && key.torsoFrame == pose->key.torsoFrame
+	 && key.oldTorsoFrame == pose->key.oldTorsoFrame
+	 && key.backlerp == pose->key.backlerp
+	 && key.torsoBacklerp == pose->key.torsoBacklerp) {
+		return pose;
+	}
+
+	pose->key = key;
+	pose->epoch = mdx_pose_epoch;
+	pose->generation++;
+
+	return pose;
 }
 
 static void mdx_calculate_bone_lerp(
+	mdx_pose_t *pose,
 	/*const*/ grefEntity_t *refent,
 	mdx_t *frameModel,
 	mdx_t *oldFrameModel,
@@ -1173,13 +1359,19 @@ static void mdx_calculate_bone_lerp(
 	bone = &boneFrameModel->bones[i];
 	oldBone = &oldBoneFrameModel->bones[i];
 
+	/* Already computed for this pose */
+	if (pose->stamps[i] == pose->generation)
+		return;
+	pose->stamps[i] = pose->generation;
+
 	if ( i == 0 ) {
-		VectorMA( vec3_origin, 1.0 - backlerp, boneFrameModel->frames[frame].parent_offset, mdx_bones[i] );
-		VectorMA( mdx_bones[i], backlerp, oldBoneFrameModel->frames[oldFrame].parent_offset, mdx_bones[i] );
+		VectorMA( vec3_origin, 1.0 - backlerp, boneFrameModel->frames[frame].parent_offset, pose->bones[i] );
+		VectorMA( pose->bones[i], backlerp, oldBoneFrameModel->frames[oldFrame].parent_offset, pose->bones[i] );
 		return; // It's offset funny if we do the calculations for the top-most bone
 	} else {
 		if (recursive) {
 			mdx_calculate_bone_lerp(
+				pose,
 				refent,
 				frameModel, oldFrameModel,
 				torsoFrameModel, oldTorsoFrameModel,
@@ -1196,17 +1388,18 @@ static void mdx_calculate_bone_lerp(
 	mdx_calculate_bone(point, bone, frameBone);
 
 	/* This frame's position */
-	VectorAdd(mdx_bones[bone->parent_index], point, mdx_bones[i]);
+	VectorAdd(pose->bones[bone->parent_index], point, pose->bones[i]);
 
 	/* Lerp in old frame */
 	VectorSubtract(oldpoint, point, oldpoint);
-	VectorMA(mdx_bones[i], backlerp, oldpoint, mdx_bones[i]);
+	VectorMA(pose->bones[i], backlerp, oldpoint, pose->bones[i]);
 }
 
 #ifdef BONE_HITTESTS
 /* Calculates all bones */
 static void mdx_calculate_bones(/*const*/ grefEntity_t *refent)
 {
+	mdx_pose_t *pose;
 	int i;
 
 	mdx_t *frameModel = &mdx_models[QHANDLETOINDEX(refent->frameModel)];
@@ -1223,13 +1416,16 @@ static void mdx_calculate_bones(/*const*/ grefEntity_t *refent)
 	}
 #endif
 
+	pose = mdx_pose_select(refent, frameModel, oldFrameModel, torsoFrameModel, oldTorsoFrameModel);
+
 	for (i = 0; i < frameModel->bone_count; i++) {
 		mdx_calculate_bone_lerp(
+			pose,
 			refent,
 			frameModel, oldFrameModel,
 			torsoFrameModel, oldTorsoFrameModel,
 			i,
-			qfalse
+			qtrue
 		);
 	}
 }
@@ -1237,6 +1433,8 @@ static void mdx_calculate_bones(/*const*/ grefEntity_t *refent)
 
 void mdx_calculate_bones_single(/*const*/ grefEntity_t *refent, int i)
 {
+	mdx_pose_t *pose;
+
 	mdx_t *frameModel = &mdx_models[QHANDLETOINDEX(refent->frameModel)];
 	mdx_t *oldFrameModel = &mdx_models[QHANDLETOINDEX_SAFE(refent->oldframeModel, refent->frameModel)];
 
@@ -1251,7 +1449,10 @@ void mdx_calculate_bones_single(/*const*/ grefEntity_t *refent, int i)
 	}
 #endif
 
+	pose = mdx_pose_select(refent, frameModel, oldFrameModel, torsoFrameModel, oldTorsoFrameModel);
+
 	mdx_calculate_bone_lerp(
+		pose,
 		refent,
 		frameModel, oldFrameModel,
 		torsoFrameModel, oldTorsoFrameModel,
@@ -1280,6 +1481,8 @@ static void mdx_bone_orientation(/*const*/ grefEntity_t *refent, int idx, vec3_t
 	vec3_t realangles, angles;
 	vec3_t axis1[3], tmpaxis[3];
 
+	const vec3_t *bones = mdx_pose_slot(refent)->bones;
+
 	if ( frameModel->bones[idx].torso_weight ) {
 		boneFrameModel = torsoFrameModel;
 		oldBoneFrameModel = oldTorsoFrameModel;
@@ -1305,7 +1508,7 @@ static void mdx_bone_orientation(/*const*/ grefEntity_t *refent, int idx, vec3_t
 	oldFrameBone = &oldBoneFrameModel->frames[oldFrame].bones[idx];
 
 	/* Calculate origin */
-	VectorCopy( mdx_bones[idx], origin );
+	VectorCopy( bones[idx], origin );
 
 	/* Apply torso rotation to origin */
 	// FIXME: This probably isn't entirely correct; my test models fail,
@@ -1315,9 +1518,9 @@ static void mdx_bone_orientation(/*const*/ grefEntity_t *refent, int idx, vec3_t
 		vec3_t tmp, torso_origin;
 
 		/* Rotate around torso_parent */
-		VectorSubtract(origin, mdx_bones[boneFrameModel->torso_parent], tmp);
+		VectorSubtract(origin, bones[boneFrameModel->torso_parent], tmp);
 		PointRotate(tmp, refent->torsoAxis, torso_origin);
-		VectorAdd(torso_origin, mdx_bones[boneFrameModel->torso_parent], torso_origin);
+		VectorAdd(torso_origin, bones[boneFrameModel->torso_parent], torso_origin);
 
 		/* Lerp torso-rotated point with non-rotated */
 		VectorSubtract(torso_origin, origin, torso_origin);
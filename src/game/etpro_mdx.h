@@ -65,9 +65,13 @@ typedef struct {
 	qhandle_t	oldTorsoFrameModel;
 	float		backlerp;			// 0.0 = current, 1.0 = old
 	float		torsoBacklerp;
+
+	int			poseSlot;			// bone pose cache slot (client number + 1, 0 = shared)
 } grefEntity_t;
 
 extern void mdx_cleanup(void);
+extern void mdx_pose_reserve(void);
+extern void mdx_pose_verify(void);
 
 extern qhandle_t trap_R_RegisterModel(const char *filename);
 
@@ -539,6 +539,7 @@ void ClientImpacts( gentity_t *ent, pmove_t *pm ) {
 			continue;
 		}
 
+		entityScheduler.wake( other );
 		other->touch( other, ent, &trace );
 	}
 
@@ -622,6 +623,7 @@ void	G_TouchTriggers( gentity_t *ent ) {
 		memset( &trace, 0, sizeof(trace) );
 
 		if ( hit->touch ) {
+			entityScheduler.wake( hit );
 			hit->touch (hit, ent, &trace);
 		}
 	}
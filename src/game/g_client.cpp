@@ -455,6 +455,7 @@ void CopyToBodyQue( gentity_t *ent ) {
 
 
 	VectorCopy ( body->s.pos.trBase, body->r.currentOrigin );
+	entityIndex.update( body );
 	trap_LinkEntity (body);
 }
 
@@ -1772,9 +1773,10 @@ void ClientUserinfoChanged( int clientNum ) {
 
     // Jaybird - also updated UserDB
     {
-        user.namex = client->pers.netname;
-        user.name = user.namex;
-        str::etDecolorize( user.name );
+        string name = client->pers.netname;
+        user.namex = name;
+        str::etDecolorize( name );
+        user.name = name;
     }
 
     if ( client->pers.connected == CON_CONNECTED ) {
@@ -1834,6 +1836,7 @@ void ClientUserinfoChanged( int clientNum ) {
 
     // index user now that values have been updated
     userDB.index( user );
+    userDB.journal( user );
 }
 
 
@@ -2113,15 +2116,18 @@ ClientConnect( string& outmsg, int clientNum, qboolean firstTime, qboolean isBot
     userDB.unindex( user );
 
 	// IP Address
-    user.ip = Info_ValueForKey( userinfo, "ip" );
-    G_StripIPPort( user.ip );
+    string ip = Info_ValueForKey( userinfo, "ip" );
+    G_StripIPPort( ip );
+    user.ip = ip;
 
     // MAC
-    user.mac = Info_ValueForKey(userinfo, "cl_mac");
-    str::toLower( user.mac );
+    string mac = Info_ValueForKey(userinfo, "cl_mac");
+    str::toLower( mac );
+    user.mac = mac;
 
     // index user after updating values
     userDB.index( user );
+    userDB.journal( user );
 
 	// Read or initialize the session data
 	if( firstTime ) {
@@ -2820,6 +2826,7 @@ void ClientDisconnect( int clientNum ) {
 	// Update client User record
     connectedUsers[clientNum]->timestamp = time( NULL );
     g_clientObjects[clientNum].xpBackup();
+    userDB.journal( *connectedUsers[clientNum] );
 
     connectedUsers[clientNum] = &User::BAD;
 
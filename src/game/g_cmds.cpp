@@ -2726,6 +2726,7 @@ qboolean Do_Activate_f(gentity_t *ent, gentity_t *traceEnt) {
 				if( ent->client->pers.autoActivate == PICKUP_ACTIVATE )
 					ent->client->pers.autoActivate = PICKUP_FORCE;		//----(SA) force pickup
 				traceEnt->active = qtrue;
+				entityScheduler.wake( traceEnt );
 				traceEnt->touch( traceEnt, ent, &trace );
 			}
 
@@ -906,6 +906,9 @@ void G_Damage( gentity_t *targ, gentity_t *inflictor, gentity_t *attacker, const
 		return;
 	}
 
+	// pain and death callbacks may change how it runs
+	entityScheduler.wake( targ );
+
 	// xkan, 12/23/2002 - was the bot alive before applying any damage?
 	wasAlive = (targ->health > 0) ? qtrue : qfalse;
 
@@ -970,6 +970,7 @@ gentity_t *LaunchItem( gitem_t *item, vec3_t origin, vec3_t velocity, int ownerN
 
 	dropped->flags = FL_DROPPED_ITEM;
 
+	entityIndex.update( dropped );
 	trap_LinkEntity (dropped);
 
 	return dropped;
@@ -1131,6 +1132,7 @@ void FinishSpawningItem( gentity_t *ent ) {
 		ent->s.density = i-1;	// store number of stages in 'density' for client (most will have '1')
 	}
 
+	entityIndex.update( ent );
 	trap_LinkEntity (ent);
 }
 
@@ -1894,6 +1894,7 @@ void G_BanPlayer(gentity_t* ent, string banner, string reason, int duration)
     user->banAuthority = SanitizeString(banner, false);
 
     userDB.index( *user );
+    userDB.journal( *user );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
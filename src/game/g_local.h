@@ -9,6 +9,7 @@
 #include <bgame/q_shared.h>
 #include <bgame/bg_public.h>
 #include <game/g_public.h>
+#include <game/ThinkTime.h>
 
 #include <ui/menudef.h>
 
@@ -354,7 +355,7 @@ struct gentity_s {
 	vec3_t		gDelta;
 	vec3_t		gDeltaBack;
 
-	int			nextthink;
+	ThinkTime	nextthink;
 	void		(*free)(gentity_t *self);
 	void		(*think)(gentity_t *self);
 	void		(*reached)(gentity_t *self);	// movers call this when hitting endpoint
@@ -537,7 +538,7 @@ struct gentity_s {
 
 	vec3_t	oldOrigin;
 
-	qboolean runthisframe;
+	int		runframe;	// level.framenum when G_RunEntity last ran
 
 	g_constructible_stats_t	constructibleStats;
 
@@ -2439,6 +2440,7 @@ typedef struct {
 ///////////////////////
 // g_main.c
 //
+void G_PollCvars(void);
 void G_UpdateCvars(void);
 void G_wipeCvars(void);
 
@@ -2673,11 +2675,18 @@ qboolean G_LandmineSnapshotCallback( int entityNum, int clientNum );
 
 #include <game/Privilege.h>
 #include <game/PrivilegeSet.h>
+#include <game/DatabaseRecord.h>
 #include <game/Level.h>
+#include <game/PooledString.h>
+#include <game/PackedAddress.h>
+#include <game/BanTrie.h>
+#include <game/UserTable.h>
 #include <game/User.h>
 #include <game/MapRecord.h>
 
 #include <game/Database.h>
+#include <game/DatabaseWriter.h>
+#include <game/MappedFile.h>
 #include <game/LevelDB.h>
 #include <game/UserDB.h>
 #include <game/MapDB.h>
@@ -2686,14 +2695,19 @@ qboolean G_LandmineSnapshotCallback( int entityNum, int clientNum );
 #include <game/MapEntity.h>
 #include <game/MapEntityList.h>
 
+#include <game/WorkerPool.h>
 #include <game/TraceContext.h>
+#include <game/TraceBatch.h>
 #include <game/AbstractBulletVolume.h>
 #include <game/AbstractBulletModel.h>
 #include <game/AbstractHitVolume.h>
 #include <game/AbstractHitModel.h>
 #include <game/Client.h>
 #include <game/Entity.h>
+#include <game/EntityScheduler.h>
+#include <game/EntityIndex.h>
 #include <game/AdminLog.h>
+#include <game/FrameProfiler.h>
 
 ///////////////////////////////////////////////////////////////////////////////
 
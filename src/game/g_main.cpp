@@ -413,9 +413,9 @@ cvarTable_t		gameCvarTable[] = {
 
 	// change anytime vars
 	{ &g_fraglimit, "fraglimit", "0", /*CVAR_SERVERINFO |*/ CVAR_ARCHIVE | CVAR_NORESTART, 0, qtrue },
-	{ &g_timelimit, "timelimit", "0", CVAR_SERVERINFO | CVAR_ARCHIVE | CVAR_NORESTART, 0, qtrue },
+	{ &g_timelimit, "timelimit", "0", CVAR_SERVERINFO | CVAR_ARCHIVE | CVAR_NORESTART | CVAR_JAYMODHOT, 0, qtrue },
 
-	{ &g_friendlyFire, "g_friendlyFire", "1", CVAR_SERVERINFO | CVAR_ARCHIVE, 0, qtrue, qtrue },
+	{ &g_friendlyFire, "g_friendlyFire", "1", CVAR_SERVERINFO | CVAR_ARCHIVE | CVAR_JAYMODHOT, 0, qtrue, qtrue },
 
 	{ &g_teamForceBalance, "g_teamForceBalance", "0", CVAR_ARCHIVE  },							// NERVE - SMF - merge from team arena
 
@@ -446,9 +446,9 @@ cvarTable_t		gameCvarTable[] = {
 
 	{ &g_dedicated, "dedicated", "0", 0, 0, qfalse },
 
-	{ &g_speed, "g_speed", "320", 0, 0, qtrue, qtrue },
-	{ &g_gravity, "g_gravity", "800", 0, 0, qtrue, qtrue },
-	{ &g_knockback, "g_knockback", "1000", 0, 0, qtrue, qtrue },
+	{ &g_speed, "g_speed", "320", CVAR_JAYMODHOT, 0, qtrue, qtrue },
+	{ &g_gravity, "g_gravity", "800", CVAR_JAYMODHOT, 0, qtrue, qtrue },
+	{ &g_knockback, "g_knockback", "1000", CVAR_JAYMODHOT, 0, qtrue, qtrue },
 	
 	{ &g_needpass, "g_needpass", "0", CVAR_SERVERINFO | CVAR_ROM, 0, qtrue },
 	{ &g_balancedteams, "g_balancedteams", "0", CVAR_SERVERINFO | CVAR_ROM, 0, qtrue },
@@ -476,8 +476,8 @@ cvarTable_t		gameCvarTable[] = {
 	{ &g_developer, "developer", "0", CVAR_TEMP, 0, qfalse },
 
 	{ &g_smoothClients, "g_smoothClients", "1", 0, 0, qfalse },
-	{ &pmove_fixed, "pmove_fixed", "0", CVAR_SYSTEMINFO, 0, qfalse },
-	{ &pmove_msec, "pmove_msec", "8", CVAR_SYSTEMINFO, 0, qfalse },
+	{ &pmove_fixed, "pmove_fixed", "0", CVAR_SYSTEMINFO | CVAR_JAYMODHOT, 0, qfalse },
+	{ &pmove_msec, "pmove_msec", "8", CVAR_SYSTEMINFO | CVAR_JAYMODHOT, 0, qfalse },
 
 	{ &g_scriptName, "g_scriptName", "", CVAR_CHEAT, 0, qfalse },
 
@@ -637,7 +637,10 @@ vmMain( int command, int arg0, int arg1, int arg2, int arg3, int arg4, int arg5,
 				return 0;
 		}
 	case GAME_CLIENT_THINK:
-        g_clientObjects[arg0].think();
+		{
+			FrameProfiler::Stopwatch watch( FrameProfiler::CLIENTTHINK );
+			g_clientObjects[arg0].think();
+		}
 		return 0;
 	case GAME_CLIENT_USERINFO_CHANGED:
 		ClientUserinfoChanged( arg0 );
@@ -649,11 +652,18 @@ vmMain( int command, int arg0, int arg1, int arg2, int arg3, int arg4, int arg5,
 		ClientBegin( arg0 );
 		return 0;
 	case GAME_CLIENT_COMMAND:
-		ClientCommand( arg0 );
+		{
+			FrameProfiler::Stopwatch watch( FrameProfiler::CLIENTCOMMAND );
+			ClientCommand( arg0 );
+		}
 		return 0;
 	case GAME_RUN_FRAME:
+		frameProfiler.frameEnd();
 		G_RunFrame( arg0 );
-		Bot_Interface_Update();
+		{
+			FrameProfiler::Stopwatch watch( FrameProfiler::BOTUPDATE );
+			Bot_Interface_Update();
+		}
 		return 0;
 	case GAME_CONSOLE_COMMAND:
  		return ConsoleCommand();
@@ -1465,13 +1475,21 @@ void G_RegisterCvars( void )
 
 /*
 =================
-G_UpdateCvars
+G_CheckCvars
+
+Polls cvars and applies any changes. With all set every cvar is polled;
+otherwise only CVAR_JAYMODHOT cvars plus the next few others in turn.
 =================
 */
-void G_UpdateCvars( void )
+#define CVAR_POLL_BUDGET 12		// gameCvarTable entries without CVAR_JAYMODHOT polled per frame
+
+static int cvarPollNext = 0;	// next gameCvarTable entry polled in turn
+
+static void G_CheckCvars( qboolean all )
 {
 	int i;
 	cvarTable_t	*cv;
+	int pollFirst;
 
 	bool fToggles          = false;
 	bool fVoteFlags        = false;
@@ -1479,7 +1497,10 @@ void G_UpdateCvars( void )
 	bool chargetimechanged = false;
 	bool jaymodChanged     = false;
 
-    Cvar::update();
+    if (all)
+        Cvar::update();
+    else
+        Cvar::poll();
 
     const list<Cvar*>& vars = Cvar::getUpdateList();
     const list<Cvar*>::const_iterator end = vars.end();
@@ -1496,8 +1517,13 @@ void G_UpdateCvars( void )
             jaymodChanged = true;
     }
 
+	pollFirst = cvarPollNext;
+	if( !all ) {
+		cvarPollNext = (cvarPollNext + CVAR_POLL_BUDGET) % gameCvarTableSize;
+	}
+
 	for ( i = 0, cv = gameCvarTable ; i < gameCvarTableSize ; i++, cv++ ) {
-		if ( cv->vmCvar ) {
+		if ( cv->vmCvar && (all || (cv->cvarFlags & CVAR_JAYMODHOT) || (i - pollFirst + gameCvarTableSize) % gameCvarTableSize < CVAR_POLL_BUDGET) ) {
 			trap_Cvar_Update( cv->vmCvar );
 
 			if(cv->modificationCount != cv->vmCvar->modificationCount) {
@@ -1650,6 +1676,31 @@ void G_UpdateCvars( void )
 	}
 }
 
+/*
+=================
+G_PollCvars
+
+Called each frame; a change to a cvar without CVAR_JAYMODHOT is noticed
+within a second or so.
+=================
+*/
+void G_PollCvars( void )
+{
+	G_CheckCvars( qfalse );
+}
+
+/*
+=================
+G_UpdateCvars
+
+Polls every cvar. Use after setting cvars that must take effect now.
+=================
+*/
+void G_UpdateCvars( void )
+{
+	G_CheckCvars( qtrue );
+}
+
 // Reset particular server variables back to defaults if a config is voted in.
 void G_wipeCvars(void)
 {
@@ -2043,7 +2094,8 @@ void G_InitGame( int levelTime, int randomSeed, int restart ) {
 	G_ResetTeamMapData();
 
 	// initialize all entities for this game
-	memset( g_entities, 0, MAX_GENTITIES * sizeof(g_entities[0]) );
+	// (void*): ThinkTime only wraps an int, so zeroing it directly is safe
+	memset( (void*)g_entities, 0, MAX_GENTITIES * sizeof(g_entities[0]) );
 	level.gentities = g_entities;
 
 	// initialize all clients for this game
@@ -2057,6 +2109,9 @@ void G_InitGame( int levelTime, int randomSeed, int restart ) {
 		g_entityObjects[i].init();
 	}
 
+	entityScheduler.init( levelTime );
+	entityIndex.init();
+
 	// set client fields on player ents
 	for (i = 0; i < level.maxclients ; i++ ) {
 		g_entities[i].client = level.clients + i;
@@ -2203,6 +2258,7 @@ void G_ShutdownGame( int restart ) {
 
     // Free any ghosts that still may be alive.
     AbstractHitModel::ghostCleanup();
+    AbstractHitModel::runShutdown();
 
 	G_DebugCloseSkillLog();
 
@@ -2231,6 +2287,7 @@ void G_ShutdownGame( int restart ) {
     userDB.purge();
 	userDB.save();
     mapDB.save();
+    dbWriter.shutdown();
 
     molotov::shutdown();
     process.shutdown();
@@ -3668,11 +3725,11 @@ void G_TagLinkEntity( gentity_t* ent, int msec ) {
 }
 
 void G_RunEntity( gentity_t* ent, int msec ) {
-	if( ent->runthisframe ) {
+	if( ent->runframe == level.framenum ) {
 		return;
 	}
 
-	ent->runthisframe = qtrue;
+	ent->runframe = level.framenum;
 
 	if( !ent->inuse ) {
 		return;
@@ -3838,6 +3895,8 @@ Advances the non-player objects in the world
 ================
 */
 void G_RunFrame( int levelTime ) {
+    FrameProfiler::Stopwatch watch( FrameProfiler::FRAME );
+
     stats::frame.sample( 1 );
 
     if (process.pendingReload) {
@@ -3923,54 +3982,81 @@ void G_RunFrame( int levelTime ) {
 		level.alliedBombCounter = 0;
 	}
 	
-	// get any cvar changes
-	G_UpdateCvars();
+	watch.lap( FrameProfiler::HOUSEKEEPING );
 
-	for( i = 0; i < level.num_entities; i++ ) {
-		g_entities[i].runthisframe = qfalse;
-	}
+	// get any cvar changes
+	G_PollCvars();
+	watch.lap( FrameProfiler::CVARS );
 
     // process molotov chunks
     molotov::runChunks();
+	watch.lap( FrameProfiler::MOLOTOV );
 
-	// go through all allocated objects
-	for( i = 0; i < level.num_entities; i++ ) {
+	// wake entities whose nextthink has come due
+	entityScheduler.advance( level.time );
+
+	// go through all awake objects, in slot order; idle ones go back to sleep
+	for( i = entityScheduler.next( 0 ); i >= 0; i = entityScheduler.next( i + 1 ) ) {
 		G_RunEntity( &g_entities[ i ], msec );
+		entityIndex.update( &g_entities[ i ] );
+		entityScheduler.settle( &g_entities[ i ] );
 	}
+	watch.lap( FrameProfiler::ENTITIES );
 
     // prune global ghosts.
     AbstractHitModel::ghostPrune();
+	watch.lap( FrameProfiler::GHOSTPRUNE );
 
 	for (i = 0; i < level.numConnectedClients; i++)
         g_clientObjects[ level.sortedClients[i] ].run();
+	watch.lap( FrameProfiler::CLIENTS );
+
+    // finish hit-models whose pose was deferred to worker threads.
+    AbstractHitModel::runDeferred();
+	watch.lap( FrameProfiler::DEFERRED );
 
     // NERVE - SMF
     CheckWolfMP();
+	watch.lap( FrameProfiler::WOLFMP );
 
 	// see if it is time to end the level
 	CheckExitRules();
+	watch.lap( FrameProfiler::EXITRULES );
 
 	// update to team status?
 	CheckTeamStatus();
+	watch.lap( FrameProfiler::TEAMSTATUS );
 
 	// cancel vote if timed out
 	CheckVote();
+	watch.lap( FrameProfiler::VOTE );
 
 	// for tracking changes
 	CheckCvars();
+	watch.lap( FrameProfiler::CVARTRACK );
 
 	G_UpdateTeamMapData();
+	watch.lap( FrameProfiler::TEAMMAPDATA );
 
 	if(level.gameManager) {
 		level.gameManager->s.otherEntityNum = MAX_TEAM_LANDMINES - G_CountTeamLandmines(TEAM_AXIS);
 		level.gameManager->s.otherEntityNum2 = MAX_TEAM_LANDMINES - G_CountTeamLandmines(TEAM_ALLIES);
 	}
+	watch.lap( FrameProfiler::LANDMINES );
 
 	// Jaybird - Jaymod per-server-frame stuff.
 	G_Banners();
+	watch.lap( FrameProfiler::BANNERS );
 	G_BinocWar(qfalse);
+	watch.lap( FrameProfiler::BINOCWAR );
     cmd::CrazyGravity::run();
+	watch.lap( FrameProfiler::CRAZYGRAVITY );
 	G_Update_CS_Airstrikes();
+	watch.lap( FrameProfiler::AIRSTRIKES );
+    userDB.journalRun();
+    userDB.purgeRun();
+    dbWriter.run();
+	watch.lap( FrameProfiler::DATABASE );
 
 	// record the time at the end of this frame - it should be about
 	// the time the next frame begins - when the server starts
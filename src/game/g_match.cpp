@@ -187,6 +187,8 @@ void G_spawnPrintf(int print_type, int print_time, gentity_t *owner)
 
 	ent->nextthink = print_time;
 	ent->think = G_delayPrint;
+
+	entityIndex.update( ent );
 }
 
 
@@ -2535,6 +2535,7 @@ static void landmine_setup( gentity_t *ent ) {
 	else
 		ent->s.otherEntityNum2 = 0;
 
+	entityIndex.update( ent );
 	trap_LinkEntity( ent );
 }
 
@@ -2786,10 +2787,9 @@ gentity_t* G_FindDynamiteTargetForTeam( gentity_t* trav, team_t team ) {
 }
 
 gentity_t* G_FindMissile( gentity_t* start, weapon_t weap ) {
-	int i = start ? (start-g_entities) + 1 : 0;
-	gentity_t* ent = &g_entities[i];
+	gentity_t* ent = entityIndex.after( EntityIndex::KIND_MISSILE, start );
 
-	for( ; i < level.num_entities; i++, ent++) {
+	for( ; ent; ent = entityIndex.after( EntityIndex::KIND_MISSILE, ent )) {
 		if( ent->s.eType != ET_MISSILE ) {
 			continue;
 		}
@@ -1390,10 +1390,8 @@ G_FadeItems
 // Gordon: changed to just set the parent to NULL
 void G_FadeItems(gentity_t* ent, int modType) {
 	gentity_t* e;
-	int i;
 
-	e = &g_entities[MAX_CLIENTS];
-	for ( i = MAX_CLIENTS ; i<level.num_entities ; i++, e++) {
+	for ( e = entityIndex.first( EntityIndex::KIND_MISSILE ); e; e = entityIndex.after( EntityIndex::KIND_MISSILE, e )) {
 		if ( !e->inuse ) {
 			continue;
 		}
@@ -1418,39 +1416,7 @@ void G_FadeItems(gentity_t* ent, int modType) {
 }
 
 int G_CountTeamLandmines ( team_t team ) {
-	gentity_t* e;
-	int i;
-	int cnt = 0;
-
-	e = &g_entities[MAX_CLIENTS];
-	for( i = MAX_CLIENTS ; i<level.num_entities ; i++, e++ ) {
-		if ( !e->inuse ) {
-			continue;
-		}
-
-		if ( e->s.eType != ET_MISSILE) {
-			continue;
-		}
-
-		switch (e->methodOfDeath) {
-			case MOD_LANDMINE:
-				break;
-
-			case MOD_POISON_GAS:
-				if (e->poisonGasWeaponType != WP_LANDMINE_PGAS)
-					continue;
-				break;
-
-			default:
-				continue;
-		}
-
-		if ( e->s.teamNum % 4 == team && e->s.teamNum < 4) {
-			cnt++;
-		}
-	}
-
-	return cnt;
+	return entityIndex.landmines( team );
 }
 
 bool G_SweepForLandmines( gentity_t* ent, float radius, int team ) {
@@ -1463,8 +1429,7 @@ bool G_SweepForLandmines( gentity_t* ent, float radius, int team ) {
 	vec3_t dist;
 	radius *= radius;
 
-	gentity_t* e = &g_entities[MAX_CLIENTS];
-	for (int i = MAX_CLIENTS; i < level.num_entities; i++, e++) {
+	for (gentity_t* e = entityIndex.first( EntityIndex::KIND_MISSILE ); e; e = entityIndex.after( EntityIndex::KIND_MISSILE, e )) {
 		if( !e->inuse ) {
 			continue;
 		}
@@ -1501,10 +1466,8 @@ bool G_SweepForLandmines( gentity_t* ent, float radius, int team ) {
 
 gentity_t *G_FindSatchel(gentity_t* ent) {
 	gentity_t* e;
-	int i;
 
-	e = &g_entities[MAX_CLIENTS];
-	for ( i = MAX_CLIENTS ; i<level.num_entities ; i++, e++) {
+	for ( e = entityIndex.first( EntityIndex::KIND_MISSILE ); e; e = entityIndex.after( EntityIndex::KIND_MISSILE, e )) {
 		if ( !e->inuse ) {
 			continue;
 		}
@@ -1535,10 +1498,8 @@ G_FindDroppedItem
 
 qboolean G_HasDroppedItem(gentity_t* ent, int modType) {
 	gentity_t* e;
-	int i;
 
-	e = &g_entities[MAX_CLIENTS];
-	for ( i = MAX_CLIENTS ; i<level.num_entities ; i++, e++) {
+	for ( e = entityIndex.first( EntityIndex::KIND_MISSILE ); e; e = entityIndex.after( EntityIndex::KIND_MISSILE, e )) {
 		if ( !e->inuse ) {
 			continue;
 		}
@@ -1580,11 +1541,9 @@ G_ExplodeSatchels
 qboolean G_ExplodeSatchels(gentity_t* ent) {
 	gentity_t* e;
 	vec3_t dist;
-	int i;
 	qboolean blown = qfalse;
 
-	e = &g_entities[MAX_CLIENTS];
-	for( i = MAX_CLIENTS ; i < level.num_entities; i++, e++ ) {
+	for ( e = entityIndex.first( EntityIndex::KIND_MISSILE ); e; e = entityIndex.after( EntityIndex::KIND_MISSILE, e )) {
 		if( !e->inuse ) {
 			continue;
 		}
@@ -1653,6 +1612,7 @@ void LandMineTrigger(gentity_t* self) {
 	self->nextthink = level.time + FRAMETIME;
 	self->think = LandminePostThink;
 	self->s.teamNum += 8;
+	entityIndex.update( self );
 	// rain - communicate trigger time to client
 	self->s.time = level.time;
 }
@@ -2239,6 +2199,8 @@ gentity_t *fire_grenade (gentity_t *self, vec3_t start, vec3_t dir, int grenadeW
 	// RF, record the time for AI
 	bolt->awaitingHelpTime = level.time;
 
+	entityIndex.update( bolt );
+
 	return bolt;
 }
 
@@ -2307,6 +2269,8 @@ gentity_t *fire_rocket (gentity_t *self, vec3_t start, vec3_t dir) {
 		bolt->s.teamNum = self->client->sess.sessionTeam;
 	}
 
+	entityIndex.update( bolt );
+
 	return bolt;
 }
 
@@ -2496,5 +2460,7 @@ gentity_t *fire_mortar(gentity_t *self, vec3_t start, vec3_t dir) {
 	SnapVector( bolt->s.pos.trDelta );			// save net bandwidth
 	VectorCopy (start, bolt->r.currentOrigin);
 
+	entityIndex.update( bolt );
+
 	return bolt;
 }
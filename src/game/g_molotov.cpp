@@ -377,6 +377,8 @@ spawn( gentity_t& actor, vec3_t start, vec3_t dir )
 
     VectorCopy( molotov.s.pos.trBase, molotov.r.currentOrigin );
 
+    entityIndex.update( &molotov );
+
     return molotov;
 }
 
@@ -713,6 +713,9 @@ void SetMoverState( gentity_t *ent, moverState_t moverState, int time ) {
 	float			f;
 	qboolean		kicked = qfalse, soft = qfalse;
 
+	// team members are set in motion without being used
+	entityScheduler.wake( ent );
+
 	kicked = (qboolean)(ent->flags & FL_KICKACTIVATE);
 	soft = (qboolean)(ent->flags & FL_SOFTACTIVATE);	//----(SA)	added
 
@@ -4469,6 +4472,7 @@ void InitConstructible( gentity_t *ent) {
 	ent->s.angles2[0] = 0;
 
 	ent->s.eType = ET_CONSTRUCTIBLE;
+	entityIndex.update( ent );
 	trap_LinkEntity (ent);
 }
 
@@ -509,6 +509,8 @@ void propExplosionLarge (gentity_t *ent)
 
 	VectorCopy (ent->r.currentOrigin, bolt->s.pos.trBase );
 	VectorCopy (ent->r.currentOrigin, bolt->r.currentOrigin);
+
+	entityIndex.update( bolt );
 }
 
 void G_ExplodeMissile( gentity_t *ent );
@@ -540,6 +542,8 @@ void propExplosion (gentity_t *ent) {
 
 	VectorCopy (ent->r.currentOrigin, bolt->s.pos.trBase );
 	VectorCopy (ent->r.currentOrigin, bolt->r.currentOrigin);
+
+	entityIndex.update( bolt );
 }
 
 void InitProp ( gentity_t *ent ) {
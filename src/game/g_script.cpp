@@ -728,6 +728,9 @@ qboolean G_Script_ScriptRun( gentity_t *ent );
 void G_Script_ScriptChange( gentity_t *ent, int newScriptNum ) {
 	g_script_status_t scriptStatusBackup;
 
+	// a script may now run every frame
+	entityScheduler.wake( ent );
+
 	// backup the current scripting
 	memcpy( &scriptStatusBackup, &ent->scriptStatus, sizeof(g_script_status_t) );
 
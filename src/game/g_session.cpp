@@ -101,6 +101,7 @@ void G_WriteClientSessionData( gclient_t *client, qboolean restart )
 
 	// Jaybird - update User record
 	connectedUsers[ client-g_clients ]->timestamp = time( NULL );
+	userDB.journal( *connectedUsers[ client-g_clients ] );
 }
 
 
@@ -1003,6 +1003,10 @@ qboolean	ConsoleCommand( void ) {
 
 	trap_Argv( 0, cmd, sizeof( cmd ) );
 
+	// The engine sets cvars from the console without telling us; catch up
+	// before a console or rcon command acts on them.
+	G_UpdateCvars();
+
 	if ( Q_stricmp (cmd, "entitylist") == 0 ) {
 		Svcmd_EntityList_f();
 		return qtrue;
@@ -677,6 +677,7 @@ void G_KillEnts( const char* target, gentity_t* ignore, gentity_t* killer, means
 			if( killer ) {
 				G_AddKillSkillPointsForDestruction( killer, mod, &targ->constructibleStats );
 			}
+			entityScheduler.wake( targ );
 			targ->die(targ, killer, killer, targ->health, 0);
 			continue;
 		}
@@ -923,8 +923,7 @@ void G_UpdateTeamMapData( void ) {
 		}
 	}
 
-	//for(i = 0, ent = g_entities; i < MAX_CLIENTS; i++, ent++) {
-	for( i = 0, ent = g_entities; i < level.num_entities; i++, ent++ ) {
+	for( i = 0, ent = g_entities; i < level.maxclients; i++, ent++ ) {
 		qboolean f1, f2;
 		if( !ent->inuse || !ent->client ) {
 			continue;
@@ -979,7 +978,8 @@ void G_UpdateTeamMapData( void ) {
 
 				G_SetupFrustum( ent );
 
-				for( j = 0, ent2 = g_entities; j < level.num_entities; j++, ent2++ ) {
+				// only clients are ET_PLAYER
+				for( j = 0, ent2 = g_entities; j < level.maxclients; j++, ent2++ ) {
 					if( !ent2->inuse || ent2 == ent ) {
 						continue;
 					}
@@ -1039,7 +1039,7 @@ void G_UpdateTeamMapData( void ) {
 				if(ent->client->ps.eFlags & EF_ZOOMING) {
 					G_SetupFrustum_ForBinoculars( ent );
 
-					for(j = 0, ent2 = g_entities; j < level.num_entities; j++, ent2++) {
+					for(ent2 = entityIndex.first( EntityIndex::KIND_MISSILE ); ent2; ent2 = entityIndex.after( EntityIndex::KIND_MISSILE, ent2 )) {
 						if(!ent2->inuse || ent2 == ent) {
 							continue;
 						}
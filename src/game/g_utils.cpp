@@ -323,6 +323,7 @@ void G_UseEntity( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
 	}
 
 	// Woop we got through, let's use the entity
+	entityScheduler.wake( ent );
 	ent->use( ent, other, activator );
 }
 
@@ -491,6 +492,8 @@ void G_InitGentity( gentity_t *e ) {
 	// mark the time
 	e->spawnTime = level.time;
 
+	entityScheduler.spawn( e );
+
 	// Notify omni-bot
 	Bot_Queue_EntityCreated(e);
 }
@@ -556,9 +559,14 @@ G_FreeEntity( gentity_t* e )
     if (e->neverFree)
         return;
 
+    entityScheduler.free( e );
+    entityIndex.remove( e );
+
     int oldsc = e->spawnCount;
 
-    memset(e, 0, sizeof(*e) );
+    // (void*): ThinkTime only wraps an int, so zeroing it directly is safe;
+    // the scheduler has already been told above.
+    memset( (void*)e, 0, sizeof(*e) );
 
     e->classname  = "freed";
     e->freetime   = level.time;
@@ -697,6 +705,8 @@ void G_AddEvent( gentity_t *ent, int event, int eventParm ) {
 		return;
 	}
 
+	entityScheduler.wake( ent );
+
 	// Ridah, use the sequential event list
 	if ( ent->client ) {
 		// NERVE - SMF - commented in - externalEvents not being handled properly in Wolf right now
@@ -767,6 +777,8 @@ Sets the pos trajectory for a fixed position
 ================
 */
 void G_SetOrigin( gentity_t *ent, vec3_t origin, bool snap ) {
+	entityScheduler.wake( ent );
+
 	VectorCopy( origin, ent->s.pos.trBase );
 	ent->s.pos.trType = TR_STATIONARY;
 	ent->s.pos.trTime = 0;
@@ -918,6 +930,8 @@ void G_SetEntState( gentity_t *ent, entState_t state ) {
 		return;
 	}
 
+	entityScheduler.wake( ent );
+
 	switch( state ) {
 	case STATE_DEFAULT:				if( ent->entstate == STATE_UNDERCONSTRUCTION ) {
 										ent->clipmask = ent->realClipmask;
@@ -1796,6 +1796,7 @@ void Weapon_Engineer( gentity_t *ent ) {
 
 					traceEnt->s.teamNum = ent->client->sess.sessionTeam;
 					traceEnt->s.modelindex2 = 0;
+					entityIndex.update( traceEnt );
 
 					traceEnt->nextthink = level.time + 2000;
 					traceEnt->think = G_LandminePrime;
@@ -2803,6 +2804,8 @@ void weapon_callAirStrike( gentity_t *ent ) {
 
 			VectorCopy( bomb->s.pos.trBase, bomb->r.currentOrigin );
 
+			entityIndex.update( bomb );
+
 			// move pos for next bomb
 			VectorAdd( pos, bombaxis, pos );
 		}
@@ -2890,6 +2893,8 @@ void artillerySpotterThink( gentity_t *ent ) {
 		SnapVector( bomb->s.pos.trDelta );			// save net bandwidth
 		VectorCopy( ent->s.pos.trBase, bomb->s.pos.trBase );
 		VectorCopy( ent->s.pos.trBase, bomb->r.currentOrigin );
+
+		entityIndex.update( bomb );
 	}
 }
 
@@ -3067,6 +3072,9 @@ void Weapon_Artillery(gentity_t *ent) {
 		VectorCopy(bomb->s.pos.trBase,bomb2->s.pos.trBase);
 		VectorCopy(bomb->s.pos.trDelta,bomb2->s.pos.trDelta);
 		VectorCopy(bomb->s.pos.trBase,bomb2->r.currentOrigin);
+
+		entityIndex.update( bomb );
+		entityIndex.update( bomb2 );
 	}
 
     if( ent->client->sess.skill[SK_SIGNALS] >= 5 && (cvars::bg_sk5_fdops.ivalue & SK5_FDO_CHARGE)) {
@@ -3212,6 +3220,8 @@ void G_PoisonGasTrip(gentity_t* ent) {
     landmine->s.pos.trDelta[1] = 0.0f;
     landmine->s.pos.trDelta[2] = 400.0f;
 
+    entityIndex.update( landmine );
+
     G_AddEvent(ent, EV_LANDMINE_LAUNCH, 0);
 }
 
@@ -3573,36 +3583,24 @@ void Bullet_Endpos(gentity_t *ent, float spread, vec3_t *end) {
 	}
 }
 
+static bool Bullet_Fire_Extended( gentity_t*, gentity_t*, vec3_t, vec3_t, int, bool, bool );
+
 /*
 ==============
-Bullet_Fire_Extended
-	A modified Bullet_Fire with more parameters.
-	The original Bullet_Fire still passes through here and functions as it always has.
-
-	uses for this include shooting through entities (windows, doors, other players, etc.) and reflecting bullets
+Bullet_Fire_Impact
+	Handles events and damage for a trace which scored a hit.
 ==============
 */
 static bool
-Bullet_Fire_Extended(
-    gentity_t* source,
-    gentity_t* actor,
-    vec3_t     start,
-    vec3_t     end,
-    int        damage,
-    bool       distanceFalloff,
-    bool       noEvents)
+Bullet_Fire_Impact(
+    TraceContext& trx,
+    gentity_t*    actor,
+    vec3_t        start,
+    vec3_t        end,
+    int           damage,
+    bool          distanceFalloff,
+    bool          noEvents)
 {
-    // Give active bullet-model a chance to adjust start point.
-    if (source->client)
-        g_clientObjects[source->s.number].bulletModel->adjustStartPoint( start );
-    else if (actor->client)
-        g_clientObjects[actor->s.number].bulletModel->adjustStartPoint( start );
-
-    // Do the trace
-    TraceContext trx(*source, *actor, MASK_SHOT, reinterpret_cast<vec_t(&)[3]>(*start), reinterpret_cast<vec_t(&)[3]>(*end) );
-    if (!AbstractBulletModel::fireWorld( trx ))
-        return qfalse;
-
     gentity_t& traceEnt = g_entities[ trx.data.entityNum ];
     RubbleFlagCheck( *actor, trx.data );
     EmitterCheck( traceEnt, *actor, trx.data );
@@ -3680,6 +3678,111 @@ Bullet_Fire_Extended(
     return hitClient;
 }
 
+/*
+==============
+Bullet_Fire_Extended
+	A modified Bullet_Fire with more parameters.
+	The original Bullet_Fire still passes through here and functions as it always has.
+
+	uses for this include shooting through entities (windows, doors, other players, etc.) and reflecting bullets
+==============
+*/
+static bool
+Bullet_Fire_Extended(
+    gentity_t* source,
+    gentity_t* actor,
+    vec3_t     start,
+    vec3_t     end,
+    int        damage,
+    bool       distanceFalloff,
+    bool       noEvents)
+{
+    // Give active bullet-model a chance to adjust start point.
+    if (source->client)
+        g_clientObjects[source->s.number].bulletModel->adjustStartPoint( start );
+    else if (actor->client)
+        g_clientObjects[actor->s.number].bulletModel->adjustStartPoint( start );
+
+    // Do the trace
+    TraceContext trx(*source, *actor, MASK_SHOT, reinterpret_cast<vec_t(&)[3]>(*start), reinterpret_cast<vec_t(&)[3]>(*end) );
+    if (!AbstractBulletModel::fireWorld( trx ))
+        return qfalse;
+
+    return Bullet_Fire_Impact( trx, actor, start, end, damage, distanceFalloff, noEvents );
+}
+
+/*
+==============
+Bullet_Fire_Multi
+	Fires several rays from a single muzzle (eg. shotgun pellets) as one batch, so that
+	players are reconciled once per shot instead of once per ray.
+	Returns true if any ray hit a client.
+==============
+*/
+static bool
+Bullet_Fire_Multi(
+    gentity_t* ent,
+    vec3_t     start,
+    vec3_t*    ends,
+    int        num,
+    int        damage,
+    bool       distanceFalloff,
+    bool       noEvents)
+{
+    // Give active bullet-model a chance to adjust start point.
+    if (ent->client)
+        g_clientObjects[ent->s.number].bulletModel->adjustStartPoint( start );
+
+    bool hitClient = false;
+    bool changed   = false;
+
+    for (int base = 0; base < num; base += AbstractBulletModel::BATCH_MAX) {
+        const int count = (num - base < AbstractBulletModel::BATCH_MAX) ? num - base : AbstractBulletModel::BATCH_MAX;
+
+        /* Once a ray changes the world (eg. kills or gibs a player, breaks an explosive)
+         * the remaining batched results may be stale, so fire the rest one by one.
+         */
+        if (changed) {
+            for (int i = 0; i < count; i++) {
+                if (Bullet_Fire_Extended( ent, ent, start, ends[base+i], damage, distanceFalloff, noEvents ))
+                    hitClient = true;
+            }
+            continue;
+        }
+
+        TraceBatch batch;
+        for (int i = 0; i < count; i++)
+            batch.add( *ent, *ent, MASK_SHOT, start, ends[base+i] );
+
+        AbstractBulletModel::fireWorld( batch.list(), count );
+
+        for (int i = 0; i < count; i++) {
+            TraceContext& trx = batch[i];
+
+            if (changed) {
+                if (Bullet_Fire_Extended( ent, ent, start, ends[base+i], damage, distanceFalloff, noEvents ))
+                    hitClient = true;
+                continue;
+            }
+
+            if (!trx.hit)
+                continue;
+
+            gentity_t& traceEnt = g_entities[ trx.data.entityNum ];
+            const int  contents = traceEnt.r.contents;
+            const bool linked   = traceEnt.r.linked;
+
+            if (Bullet_Fire_Impact( trx, ent, start, ends[base+i], damage, distanceFalloff, noEvents ))
+                hitClient = true;
+
+            if (!traceEnt.inuse || traceEnt.r.contents != contents || bool(traceEnt.r.linked) != linked)
+                changed = true;
+        }
+    }
+
+    return hitClient;
+}
+
 /*
 ==============
 Bullet_Fire
@@ -3726,9 +3829,9 @@ only be able to shoot once a second.
 */
 void Weapon_M97( gentity_t *ent ) {
 	int			i;
-	bool		hitClient = false;
+	bool		hitClient;
 	int			hits, totalHits, seed;
-	vec3_t		end;
+	vec3_t		ends[M97_COUNT];
 
     // Send the shotgun event
     gentity_t* ev = G_TempEntity(__muzzleTrace, EV_M97);
@@ -3756,14 +3859,13 @@ void Weapon_M97( gentity_t *ent ) {
         // Get the endpoint
 		r = Q_crandom( &seed ) * M97_SPREAD * 16;
 		u = Q_crandom( &seed ) * M97_SPREAD * 16;
-		VectorMA( ev->s.pos.trBase, 8192 * 16, __forward, end);
-		VectorMA (end, r, __right, end);
-		VectorMA (end, u, __up, end);
-    
-        if (Bullet_Fire_Extended( ent, ent, __muzzleTrace, end, M97_DAMAGE, qtrue, true ) && !hitClient )
-            hitClient = true;
+		VectorMA( ev->s.pos.trBase, 8192 * 16, __forward, ends[i]);
+		VectorMA (ends[i], r, __right, ends[i]);
+		VectorMA (ends[i], u, __up, ends[i]);
     }
 
+    hitClient = Bullet_Fire_Multi( ent, __muzzleTrace, ends, M97_COUNT, M97_DAMAGE, qtrue, true );
+
     // Now give stats
 	if( hitClient ) {
 		ent->client->sess.aWeaponStats[BG_WeapStatForWeapon(WP_M97)].hits = ++hits;
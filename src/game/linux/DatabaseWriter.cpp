@@ -0,0 +1,105 @@
+#include <bgame/impl.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct DatabaseWriter::Platform
+{
+    DatabaseWriter* writer;
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    sem_t           wake;
+
+    static void* threadMain( void* );
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+void*
+DatabaseWriter::Platform::threadMain( void* arg )
+{
+    Platform& platform = *static_cast<Platform*>( arg );
+
+    // Writer never handles signals; those remain with the engine's main thread.
+    sigset_t mask;
+    sigfillset( &mask );
+    pthread_sigmask( SIG_BLOCK, &mask, NULL );
+
+    DatabaseWriter::writerMain( *platform.writer );
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformJoin()
+{
+    pthread_join( _platform->thread, NULL );
+    sem_destroy( &_platform->wake );
+    pthread_mutex_destroy( &_platform->lock );
+
+    delete _platform;
+    _platform = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformLock()
+{
+    pthread_mutex_lock( &_platform->lock );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+DatabaseWriter::platformSpawn()
+{
+    // Assigned before the thread starts; the thread reaches it through this.
+    Platform* const platform = new Platform;
+    platform->writer = this;
+    _platform = platform;
+    pthread_mutex_init( &platform->lock, NULL );
+    sem_init( &platform->wake, 0, 0 );
+
+    if (pthread_create( &platform->thread, NULL, Platform::threadMain, platform )) {
+        sem_destroy( &platform->wake );
+        pthread_mutex_destroy( &platform->lock );
+        delete platform;
+        _platform = 0;
+        return false;
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformUnlock()
+{
+    pthread_mutex_unlock( &_platform->lock );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformWaitWake()
+{
+    while (sem_wait( &_platform->wake ) && errno == EINTR)
+        ;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformWake()
+{
+    sem_post( &_platform->wake );
+}
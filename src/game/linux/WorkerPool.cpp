@@ -0,0 +1,161 @@
+#include <bgame/impl.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <errno.h>
+#include <fenv.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct WorkerPool::Platform
+{
+    struct Lane {
+        WorkerPool* pool;
+        int         index;
+        pthread_t   thread;
+        sem_t       wake;
+    };
+
+    Lane   lanes[WORKERS_MAX+1];
+    sem_t  done;
+    fenv_t fpu;
+
+    static void* threadMain( void* );
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+void*
+WorkerPool::Platform::threadMain( void* arg )
+{
+    Lane& lane = *static_cast<Lane*>( arg );
+
+    // Workers never handle signals; those remain with the engine's main thread.
+    sigset_t mask;
+    sigfillset( &mask );
+    pthread_sigmask( SIG_BLOCK, &mask, NULL );
+
+    WorkerPool::workerMain( *lane.pool, lane.index );
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+semWait( sem_t& sem )
+{
+    while (sem_wait( &sem ) && errno == EINTR)
+        ;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // namespace anonymous
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformAlloc()
+{
+    if (_platform)
+        return;
+
+    _platform = new Platform;
+    sem_init( &_platform->done, 0, 0 );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformDone()
+{
+    sem_post( &_platform->done );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformFpuApply()
+{
+    fesetenv( &_platform->fpu );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformFpuSave()
+{
+    fegetenv( &_platform->fpu );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformFree()
+{
+    if (!_platform)
+        return;
+
+    sem_destroy( &_platform->done );
+    delete _platform;
+    _platform = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformJoin( int index )
+{
+    Platform::Lane& lane = _platform->lanes[index];
+    pthread_join( lane.thread, NULL );
+    sem_destroy( &lane.wake );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+WorkerPool::platformSpawn( int index )
+{
+    Platform::Lane& lane = _platform->lanes[index];
+    lane.pool  = this;
+    lane.index = index;
+    sem_init( &lane.wake, 0, 0 );
+
+    if (pthread_create( &lane.thread, NULL, Platform::threadMain, &lane )) {
+        sem_destroy( &lane.wake );
+        return false;
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformWaitDone()
+{
+    semWait( _platform->done );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformWaitWake( int index )
+{
+    semWait( _platform->lanes[index].wake );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformWake( int index )
+{
+    sem_post( &_platform->lanes[index].wake );
+}
@@ -0,0 +1,111 @@
+#include <bgame/impl.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include <signal.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct DatabaseWriter::Platform
+{
+    DatabaseWriter* writer;
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;     // unnamed POSIX semaphores are not implemented on OS X
+    int             pending;  // wakes not yet consumed, guarded by lock
+
+    static void* threadMain( void* );
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+void*
+DatabaseWriter::Platform::threadMain( void* arg )
+{
+    Platform& platform = *static_cast<Platform*>( arg );
+
+    // Writer never handles signals; those remain with the engine's main thread.
+    sigset_t mask;
+    sigfillset( &mask );
+    pthread_sigmask( SIG_BLOCK, &mask, NULL );
+
+    DatabaseWriter::writerMain( *platform.writer );
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformJoin()
+{
+    pthread_join( _platform->thread, NULL );
+    pthread_cond_destroy( &_platform->wake );
+    pthread_mutex_destroy( &_platform->lock );
+
+    delete _platform;
+    _platform = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformLock()
+{
+    pthread_mutex_lock( &_platform->lock );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+DatabaseWriter::platformSpawn()
+{
+    // Assigned before the thread starts; the thread reaches it through this.
+    Platform* const platform = new Platform;
+    platform->writer = this;
+    _platform = platform;
+    platform->pending = 0;
+    pthread_mutex_init( &platform->lock, NULL );
+    pthread_cond_init( &platform->wake, NULL );
+
+    if (pthread_create( &platform->thread, NULL, Platform::threadMain, platform )) {
+        pthread_cond_destroy( &platform->wake );
+        pthread_mutex_destroy( &platform->lock );
+        delete platform;
+        _platform = 0;
+        return false;
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformUnlock()
+{
+    pthread_mutex_unlock( &_platform->lock );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformWaitWake()
+{
+    pthread_mutex_lock( &_platform->lock );
+    while (!_platform->pending)
+        pthread_cond_wait( &_platform->wake, &_platform->lock );
+    _platform->pending--;
+    pthread_mutex_unlock( &_platform->lock );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformWake()
+{
+    pthread_mutex_lock( &_platform->lock );
+    _platform->pending++;
+    pthread_cond_signal( &_platform->wake );
+    pthread_mutex_unlock( &_platform->lock );
+}
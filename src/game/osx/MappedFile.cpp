@@ -0,0 +1,50 @@
+#include <bgame/impl.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+MappedFile::close()
+{
+    if (!_data)
+        return;
+
+    munmap( const_cast<char*>( _data ), _size );
+    _data = 0;
+    _size = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+MappedFile::open( const string& fname )
+{
+    close();
+
+    const int fd = ::open( fname.c_str(), O_RDONLY );
+    if (fd == -1)
+        return true;
+
+    struct stat st;
+    if (fstat( fd, &st ) || st.st_size <= 0) {
+        ::close( fd );
+        return true;
+    }
+
+    // Mapping stays valid after the descriptor is closed.
+    void* const addr = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+
+    if (addr == MAP_FAILED)
+        return true;
+
+    _data = static_cast<const char*>( addr );
+    _size = st.st_size;
+    return false;
+}
@@ -0,0 +1,188 @@
+#include <bgame/impl.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <fenv.h>
+#include <pthread.h>
+#include <signal.h>
+
+namespace {
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Counting semaphore; unnamed POSIX semaphores are not implemented on OS X.
+struct Semaphore
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    int             count;
+
+    void init()
+    {
+        pthread_mutex_init( &mutex, NULL );
+        pthread_cond_init( &cond, NULL );
+        count = 0;
+    }
+
+    void destroy()
+    {
+        pthread_cond_destroy( &cond );
+        pthread_mutex_destroy( &mutex );
+    }
+
+    void post()
+    {
+        pthread_mutex_lock( &mutex );
+        count++;
+        pthread_cond_signal( &cond );
+        pthread_mutex_unlock( &mutex );
+    }
+
+    void wait()
+    {
+        pthread_mutex_lock( &mutex );
+        while (!count)
+            pthread_cond_wait( &cond, &mutex );
+        count--;
+        pthread_mutex_unlock( &mutex );
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // namespace anonymous
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct WorkerPool::Platform
+{
+    struct Lane {
+        WorkerPool* pool;
+        int         index;
+        pthread_t   thread;
+        Semaphore   wake;
+    };
+
+    Lane      lanes[WORKERS_MAX+1];
+    Semaphore done;
+    fenv_t    fpu;
+
+    static void* threadMain( void* );
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+void*
+WorkerPool::Platform::threadMain( void* arg )
+{
+    Lane& lane = *static_cast<Lane*>( arg );
+
+    // Workers never handle signals; those remain with the engine's main thread.
+    sigset_t mask;
+    sigfillset( &mask );
+    pthread_sigmask( SIG_BLOCK, &mask, NULL );
+
+    WorkerPool::workerMain( *lane.pool, lane.index );
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformAlloc()
+{
+    if (_platform)
+        return;
+
+    _platform = new Platform;
+    _platform->done.init();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformDone()
+{
+    _platform->done.post();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformFpuApply()
+{
+    fesetenv( &_platform->fpu );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformFpuSave()
+{
+    fegetenv( &_platform->fpu );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformFree()
+{
+    if (!_platform)
+        return;
+
+    _platform->done.destroy();
+    delete _platform;
+    _platform = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformJoin( int index )
+{
+    Platform::Lane& lane = _platform->lanes[index];
+    pthread_join( lane.thread, NULL );
+    lane.wake.destroy();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+WorkerPool::platformSpawn( int index )
+{
+    Platform::Lane& lane = _platform->lanes[index];
+    lane.pool  = this;
+    lane.index = index;
+    lane.wake.init();
+
+    if (pthread_create( &lane.thread, NULL, Platform::threadMain, &lane )) {
+        lane.wake.destroy();
+        return false;
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformWaitDone()
+{
+    _platform->done.wait();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformWaitWake( int index )
+{
+    _platform->lanes[index].wake.wait();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformWake( int index )
+{
+    _platform->lanes[index].wake.post();
+}
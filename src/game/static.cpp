@@ -71,8 +71,8 @@ namespace objects {
 
     Cvar bg_covertops          ( "g_covertops",          "0", CVAR_ARCHIVE | CVAR_JAYMODINFO );
 
-    Cvar bg_fixedphysics       ( "g_fixedphysics",        "1",   CVAR_JAYMODINFO );
-    Cvar bg_fixedphysicsfps    ( "g_fixedphysicsfps",     "125", CVAR_JAYMODINFO );
+    Cvar bg_fixedphysics       ( "g_fixedphysics",        "1",   CVAR_JAYMODINFO | CVAR_JAYMODHOT );
+    Cvar bg_fixedphysicsfps    ( "g_fixedphysicsfps",     "125", CVAR_JAYMODINFO | CVAR_JAYMODHOT );
 
     Cvar bg_proneDelay         ( "g_proneDelay",          "0",   CVAR_JAYMODINFO );
 
@@ -87,15 +87,22 @@ namespace objects {
     Cvar g_bulletmodeReference ( "g_bulletmodeReference", "1", 0, NULL );
     Cvar g_bulletmodeTrail     ( "g_bulletmodeTrail",     "0", 0, AbstractBulletModel::cvarTrail );
 
+    Cvar g_dbBinary         ( "g_dbBinary",         "0",     CVAR_ARCHIVE );
+    Cvar g_dbJournal        ( "g_dbJournal",        "5",     CVAR_ARCHIVE );
+    Cvar g_dbJournalCompact ( "g_dbJournalCompact", "10000", CVAR_ARCHIVE );
+
     Cvar g_hitmodeAntilag      ( "g_hitmodeAntilag",     "800", 0, AbstractHitModel::cvarAntilag );
     Cvar g_hitmodeAntilagLerp  ( "g_hitmodeAntilagLerp",   "1", 0, AbstractHitModel::cvarAntilagLerp );
     Cvar g_hitmodeDebug        ( "g_hitmodeDebug",         "0", 0, NULL );
     Cvar g_hitmodeFat          ( "g_hitmodeFat",           "0", 0, AbstractHitModel::cvarFat );
     Cvar g_hitmodeGhosting     ( "g_hitmodeGhosting",      "0", 0, AbstractHitModel::cvarGhosting );
+    Cvar g_hitmodeLazy         ( "g_hitmodeLazy",          "0", 0, AbstractHitModel::cvarLazy );
     Cvar g_hitmodeReference    ( "g_hitmodeReference",     "1", 0, NULL );
+    Cvar g_hitmodeThreads      ( "g_hitmodeThreads",       "0", 0, AbstractHitModel::cvarThreads );
     Cvar g_hitmodeZone         ( "g_hitmodeZone",          "1", 0, AbstractHitModel::cvarZone );
 
     Cvar g_maxLandmines ( "team_maxLandmines", "10" );
+    Cvar g_perf         ( "g_perf",            "0", 0, FrameProfiler::cvarPerf );
     Cvar g_shutdownExit ( "g_shutdownExit",    "0" );
     Cvar g_snap         ( "g_snap",            "7" );
     Cvar g_warmup       ( "g_warmup",          "60", 0, cb_g_warmup );
@@ -186,14 +193,18 @@ namespace builtins {
     AdminTest    adminTest;
     Ban          ban;
     BanInfo      banInfo;
+    BanIP        banIP;
     BanList      banList;
     BanUser      banUser;
     CancelVote   cancelVote;
     Chicken      chicken;
     CrazyGravity crazygravity;
     CryBaby      crybaby;
+    DbExport     dbExport;
+    DbImport     dbImport;
     DbLoad       dbLoad;
     DbSave       dbSave;
+    DbStats      dbStats;
     Disorient    disorient;
     FTime        ftime;
     Finger       finger;
@@ -221,6 +232,7 @@ namespace builtins {
     Pants        pants;
     PanzerWar    panzerwar;
     Pause        pause;
+    Perf         perf;
     Pip          pip;
     Pop          pop;
     PutTeam      putTeam;
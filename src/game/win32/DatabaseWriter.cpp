@@ -0,0 +1,102 @@
+#include <bgame/impl.h>
+#include <windows.h>
+#include <process.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct DatabaseWriter::Platform
+{
+    DatabaseWriter*  writer;
+    HANDLE           thread;
+    CRITICAL_SECTION lock;
+    HANDLE           wake;
+
+    static unsigned __stdcall threadMain( void* );
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+unsigned __stdcall
+DatabaseWriter::Platform::threadMain( void* arg )
+{
+    Platform& platform = *static_cast<Platform*>( arg );
+    DatabaseWriter::writerMain( *platform.writer );
+    return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformJoin()
+{
+    WaitForSingleObject( _platform->thread, INFINITE );
+    CloseHandle( _platform->thread );
+    CloseHandle( _platform->wake );
+    DeleteCriticalSection( &_platform->lock );
+
+    delete _platform;
+    _platform = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformLock()
+{
+    EnterCriticalSection( &_platform->lock );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+DatabaseWriter::platformSpawn()
+{
+    Platform* const platform = new Platform;
+    platform->writer = this;
+    platform->wake   = CreateSemaphore( NULL, 0, MAXLONG, NULL );
+
+    if (!platform->wake) {
+        delete platform;
+        return false;
+    }
+
+    InitializeCriticalSection( &platform->lock );
+
+    // Assigned before the thread starts; the thread reaches it through this.
+    _platform = platform;
+
+    platform->thread = (HANDLE)_beginthreadex( NULL, 0, Platform::threadMain, platform, 0, NULL );
+    if (!platform->thread) {
+        DeleteCriticalSection( &platform->lock );
+        CloseHandle( platform->wake );
+        delete platform;
+        _platform = 0;
+        return false;
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformUnlock()
+{
+    LeaveCriticalSection( &_platform->lock );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformWaitWake()
+{
+    WaitForSingleObject( _platform->wake, INFINITE );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+DatabaseWriter::platformWake()
+{
+    ReleaseSemaphore( _platform->wake, 1, NULL );
+}
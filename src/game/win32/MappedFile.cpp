@@ -0,0 +1,49 @@
+#include <bgame/impl.h>
+#include <windows.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+MappedFile::close()
+{
+    if (!_data)
+        return;
+
+    UnmapViewOfFile( _data );
+    _data = 0;
+    _size = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+MappedFile::open( const string& fname )
+{
+    close();
+
+    HANDLE file = CreateFileA( fname.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if (file == INVALID_HANDLE_VALUE)
+        return true;
+
+    LARGE_INTEGER fsize;
+    if (!GetFileSizeEx( file, &fsize ) || fsize.QuadPart <= 0 || fsize.HighPart) {
+        CloseHandle( file );
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMapping( file, NULL, PAGE_READONLY, 0, 0, NULL );
+    CloseHandle( file );
+    if (!mapping)
+        return true;
+
+    // View stays valid after both handles are closed.
+    void* const addr = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    CloseHandle( mapping );
+
+    if (!addr)
+        return true;
+
+    _data = static_cast<const char*>( addr );
+    _size = size_t( fsize.QuadPart );
+    return false;
+}
@@ -0,0 +1,139 @@
+#include <bgame/impl.h>
+#include <windows.h>
+#include <float.h>
+#include <process.h>
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct WorkerPool::Platform
+{
+    struct Lane {
+        WorkerPool* pool;
+        int         index;
+        HANDLE      thread;
+        HANDLE      wake;
+    };
+
+    Lane         lanes[WORKERS_MAX+1];
+    HANDLE       done;
+    unsigned int fpu;
+
+    static unsigned __stdcall threadMain( void* );
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+unsigned __stdcall
+WorkerPool::Platform::threadMain( void* arg )
+{
+    Lane& lane = *static_cast<Lane*>( arg );
+    WorkerPool::workerMain( *lane.pool, lane.index );
+    return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformAlloc()
+{
+    if (_platform)
+        return;
+
+    _platform = new Platform;
+    _platform->done = CreateSemaphore( NULL, 0, WORKERS_MAX, NULL );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformDone()
+{
+    ReleaseSemaphore( _platform->done, 1, NULL );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformFpuApply()
+{
+    // New threads start with CRT default precision; the engine may have changed it.
+    _controlfp( _platform->fpu, _MCW_PC | _MCW_RC );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformFpuSave()
+{
+    _platform->fpu = _controlfp( 0, 0 );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformFree()
+{
+    if (!_platform)
+        return;
+
+    CloseHandle( _platform->done );
+    delete _platform;
+    _platform = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformJoin( int index )
+{
+    Platform::Lane& lane = _platform->lanes[index];
+    WaitForSingleObject( lane.thread, INFINITE );
+    CloseHandle( lane.thread );
+    CloseHandle( lane.wake );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+WorkerPool::platformSpawn( int index )
+{
+    Platform::Lane& lane = _platform->lanes[index];
+    lane.pool  = this;
+    lane.index = index;
+    lane.wake  = CreateSemaphore( NULL, 0, 1, NULL );
+
+    if (!lane.wake)
+        return false;
+
+    lane.thread = (HANDLE)_beginthreadex( NULL, 0, Platform::threadMain, &lane, 0, NULL );
+    if (!lane.thread) {
+        CloseHandle( lane.wake );
+        return false;
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformWaitDone()
+{
+    WaitForSingleObject( _platform->done, INFINITE );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformWaitWake( int index )
+{
+    WaitForSingleObject( _platform->lanes[index].wake, INFINITE );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+WorkerPool::platformWake( int index )
+{
+    ReleaseSemaphore( _platform->lanes[index].wake, 1, NULL );
+}